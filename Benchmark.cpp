@@ -0,0 +1,497 @@
+/*
+ Author: Emma Kimlin
+ Title: Benchmark.cpp
+ Date Created: 10.18.2026
+ Description: End-to-end throughput benchmark. Drives a complete Scheduler with a synthetic mix of arrivals, preemptions,
+              printer/disk/CD_RW system calls and interrupts, kills, forks and Job Pool pressure. Every event is fed to the
+              Scheduler exactly as a user would type it, together with the answers to the questions it asks.
+              Reports sustained events/sec, peak RSS and per-event latency percentiles, and can store or compare
+              against a baseline file.
+ Build: make bench.me (or "make release", "make pgo"; "make compare" reports the speedup of each over this build)
+ Usage: ./bench.me [-n num_events] [-s seed] [-w balanced|io|memory] [-c basic|paging|pff|swap|cow] [-t f|2|3|h]
+                  [-L large_page_pages] [-N numa_nodes] [-a f|i] [-b io_batch]
+                  [-k cache_frames] [-K l|2|a] [-A async_depth] [-F SSD_channels] [-g aging_percent] [-G alarm_ms]
+                  [-x switch_us] [-R e|r] [-T] [-P num_groups] [-C num_CPUs] [-E p|s|o|e] [-e max_slowdown_percent]
+                  [--save-baseline file] [--baseline file] [-v]
+        -c selects the system generation: "basic" answers no to the advanced options, "paging" uses demand paging
+           with mixed reference strings and working-set load control, "pff" uses page-fault-frequency load control,
+           "swap" swaps blocked processes out to admit jobs, "cow" runs instances of a few programs that share code
+           pages, with writes that split pages shared by forks.
+        -t selects the page table of every system but "basic": flat (default), two-level, three-level or hashed inverted.
+        -L sets the large page size in base pages of every system but "basic" (default 0, base pages only).
+        -N splits memory of every system but "basic" into NUMA nodes (default 1), -a picks first-touch (default) or
+           interleaved allocation across them.
+        -b lets a device interrupt complete up to io_batch queued requests for the same file (default 1, no merging).
+        -k gives the disk buffer cache cache_frames frames (default 0, no cache); -K picks its policy: LRU (default),
+           2Q or ARC.
+        -A lets every process keep up to async_depth asynchronous requests in flight (default 0, synchronous I/O only).
+           Three of four system calls are then submitted asynchronously and the fourth reaps completions.
+        -F adds as many SSDs as disks, each with SSD_channels channels, and sends the disk requests of the workload to
+           them instead (default 0, no SSDs), to compare rotational disks with flash under the same events.
+        -g sets the Ready Queue aging rate in percent of a ms of burst per ms waited (default 0, no aging); -G the wait
+           in ms that raises the starvation alarm (default 0, none).
+        -x sets the cost of a context switch in us; an arrival preempts only if it saves more (default 0, preempt
+           whenever the arrival is not longer). Half of it is the TLB flush, saved between threads of a process.
+        -R schedules real-time tasks by earliest deadline first or rate-monotonic (default none). One arrival in four is
+           then a periodic task, which the schedulability test may reject.
+        -T turns the forks of the workload into thread creations, which share the memory of their process.
+        -P places arrivals at random in num_groups top-level process groups (default 0, none). Group i has weight i,
+           and each may hold half of memory and make a limited number of I/O requests per second to each device.
+        -C records the bursts run and replays them on num_CPUs CPUs (default 1, not modeled), comparing gang scheduling
+           with independent SJF after the report. Gangs are the process groups with -P, else the threads of a process.
+        -E models the energy of the CPU and the devices under the performance, powersave, ondemand or energy-aware
+           governor (default none), and prints it after the report; -e sets the most the energy-aware governor may
+           slow a burst down, in percent (default 20).
+        -v shows the Scheduler's own output instead of discarding it, to check what the workload exercises.
+ */
+
+#include "Scheduler.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+/********************Utility Functions********************/
+namespace BenchmarkNamespace {
+
+//Build configuration the makefile compiled this with, so reports of different builds can be told apart.
+#define BENCH_STRING(x) #x
+#define BENCH_EXPAND(x) BENCH_STRING(x)
+#ifdef SIM_BUILD
+const char* kBuild = BENCH_EXPAND(SIM_BUILD);
+#else
+const char* kBuild = "unknown";
+#endif
+
+//System generation used for every run. Sizes are chosen so that the Job Pool fills up under load.
+const int kTotalMemory = 16384;
+const int kMaxProcessSize = 4096;
+const int kPageSize = 256;
+const int kNumPrinters = 2;
+const int kNumDisks = 2;
+const int kNumCD_RW = 2;
+const int kNumCylinders = 200;
+const int kLocalAccessNs = 100;
+const int kRemoteAccessNs = 160;
+const int kMergeWindow = 8; //Queued requests a device looks through for merges when -b is given
+const int kFlushInterval = 32; //Disk requests between flushes of the buffer cache when -k is given
+const int kSSDServiceUs = 100; //Time an SSD channel takes per request when -F is given
+const int kMinPeriod = 20; //Periods of the real-time tasks when -R is given, in ms
+const int kMaxPeriod = 200;
+const int kGroupFrames = kTotalMemory / kPageSize / 2; //Frame limit of every process group when -P is given
+const int kGroupIORate = 3; //I/O requests per second a process group may make to each device when -P is given
+const int kUsageAnswers = 64; //Length of the repeating tail of answers to "How long did this process use the CPU".
+
+//Streambuf that discards everything written to it. Scheduler output is sent here while timing.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) { return n; }
+};
+
+//Streambuf that serves one event and then repeats a tail of CPU usage answers forever. How many times an event asks
+//for CPU usage depends on the Scheduler's state (preemptions, admissions from the Job Pool, resumptions), so the
+//benchmark cannot know in advance how many answers it needs.
+class EventBuffer : public std::streambuf {
+public:
+    void SetTail(const std::string& tail) { tail_ = tail; }
+    void Load(const std::string& event) {
+        event_ = event;
+        char* start = const_cast<char*>(event_.data());
+        setg(start, start, start + event_.size());
+    }
+protected:
+    int underflow() {
+        char* start = const_cast<char*>(tail_.data());
+        setg(start, start, start + tail_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+private:
+    std::string event_;
+    std::string tail_;
+};
+
+//Relative weight of each kind of event in a workload mix.
+struct WorkloadMix {
+    std::string name;
+    int arrival;
+    int terminate;
+    int syscall;
+    int interrupt;
+    int kill;
+    int snapshot;
+    int fork;
+};
+
+const WorkloadMix kMixes[] = {
+    //name        A   t   p/c/d  P/C/D  K  S  f
+    { "balanced", 20,  8,   30,    32,  5, 5, 4 },
+    { "io",       10,  4,   42,    40,  2, 2, 1 },
+    { "memory",   40, 12,   20,    18,  8, 2, 8 },
+};
+
+//Answers to the advanced memory questions asked before the page table, large page and NUMA questions.
+struct SystemConfig {
+    std::string name;
+    std::string memory_options; //"n" for none
+    int num_programs; //Arrivals name one of this many programs when code pages are shared; 0 if they are not
+};
+
+const SystemConfig kConfigs[] = {
+    { "basic",  "n",                                0 },
+    { "paging", "y y 64 m 5 0 w y y n 2 1 n",       0 },
+    { "pff",    "y y 64 m 5 0 p 20 150 y n 2 1 n",  0 },
+    { "swap",   "y n 64 n y b 8 1 n",               0 },
+    { "cow",    "y y 64 m 5 20 w y y n 2 1 y 50",   4 },
+};
+
+struct Results {
+    double events_per_sec;
+    double p50_us;
+    double p90_us;
+    double p99_us;
+    double p999_us;
+    double max_us;
+    long peak_rss_kb;
+};
+
+int RandomBetween(int low, int high) { return low + rand() % (high - low + 1); }
+
+//Answers to the questions ProcessSyscall asks, in the order it asks them.
+std::string SyscallAnswers(char device) {
+    std::ostringstream answers;
+    answers << " file" << RandomBetween(1, 50) << " " << std::hex << RandomBetween(0, kPageSize - 1) << std::dec;
+    if (device != 'p')
+        answers << (RandomBetween(0, 1) ? " r" : " w");
+    answers << " " << RandomBetween(1, 4096);
+    if (device == 'd')
+        answers << " " << RandomBetween(1, kNumCylinders);
+    else if (device == 'n') //An SSD has no cylinders; draw the same number of random values as a disk request.
+        RandomBetween(1, kNumCylinders);
+    return answers.str();
+}
+
+//Builds one event: the command followed by the answers to the questions it asks, other than CPU usage.
+std::string MakeEvent(const WorkloadMix& mix, const SystemConfig& config, bool async_io, bool flash, bool real_time,
+                      bool threads, int num_groups, int& num_arrivals) {
+    int total = mix.arrival + mix.terminate + mix.syscall + mix.interrupt + mix.kill + mix.snapshot + mix.fork;
+    int pick = rand() % total;
+    std::ostringstream event;
+    const char devices[] = { 'p', 'c', flash ? 'n' : 'd' };
+    const int device_count[] = { kNumPrinters, kNumCD_RW, kNumDisks };
+    if ( (pick -= mix.arrival) < 0 ) {
+        if (config.num_programs > 0) { //Every instance of a program has the same size.
+            int program = rand() % config.num_programs;
+            event << "A " << kMaxProcessSize * (program + 1) / config.num_programs << " prog" << program;
+        } else
+            event << "A " << kPageSize * RandomBetween(1, kMaxProcessSize / kPageSize);
+        if (num_groups > 0) event << " " << RandomBetween(0, num_groups);
+        if ( real_time && (rand() % 4 == 0) ) { //Period, CPU time per job, deadline at the end of the period
+            int period = RandomBetween(kMinPeriod, kMaxPeriod);
+            event << " " << period << " " << std::max(1, period / 10) << " 0";
+        } else if (real_time)
+            event << " 0";
+        ++num_arrivals;
+    } else if ( (pick -= mix.terminate) < 0 )
+        event << "t";
+    else if ( (pick -= mix.syscall) < 0 ) {
+        int which = rand() % 3;
+        if ( async_io && (rand() % 4 == 0) ) return "r";
+        if (async_io) event << "a";
+        event << devices[which] << RandomBetween(1, device_count[which]) << SyscallAnswers(devices[which]);
+    } else if ( (pick -= mix.interrupt) < 0 ) {
+        int which = rand() % 3;
+        event << char(devices[which] - 'a' + 'A') << RandomBetween(1, device_count[which]);
+    } else if ( (pick -= mix.kill) < 0 ) {
+        if (num_arrivals == 0) event << "t";
+        else event << "K" << RandomBetween(1, num_arrivals);
+    } else if ( (pick -= mix.fork) < 0 ) {
+        event << (threads ? "h" : "f");
+        ++num_arrivals;
+    } else {
+        const char* views[] = { "r", "m", "j" };
+        event << "S " << views[rand() % 3];
+    }
+    return event.str();
+}
+
+//Same dispatch as main(); kept identical so the benchmark measures what a user would run.
+void Dispatch(Scheduler& my_system, const std::string& user_input) {
+    if (user_input == "A")
+        my_system.AddNewProcess();
+    else if (user_input == "t")
+        my_system.TerminateProcessInCPU();
+    else if (user_input == "f")
+        my_system.ForkProcessInCPU();
+    else if (user_input == "h")
+        my_system.CreateThreadInCPU();
+    else if (user_input == "S")
+        my_system.Snapshot();
+    else if (user_input == "r")
+        my_system.ReapCompletions();
+    else
+        my_system.ParseCommand(user_input);
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t index = (size_t)(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+long PeakRSS_KB() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+void SaveBaseline(const std::string& filename, const Results& r) {
+    std::ofstream out(filename.c_str());
+    out << "events_per_sec " << r.events_per_sec << "\n" << "p50_us " << r.p50_us << "\n" << "p90_us " << r.p90_us << "\n"
+        << "p99_us " << r.p99_us << "\n" << "p999_us " << r.p999_us << "\n" << "max_us " << r.max_us << "\n"
+        << "peak_rss_kb " << r.peak_rss_kb << "\n";
+}
+
+bool LoadBaseline(const std::string& filename, Results& r) {
+    std::ifstream in(filename.c_str());
+    if (!in) return false;
+    std::string key;
+    double value;
+    while (in >> key >> value) {
+        if (key == "events_per_sec") r.events_per_sec = value;
+        else if (key == "p50_us") r.p50_us = value;
+        else if (key == "p90_us") r.p90_us = value;
+        else if (key == "p99_us") r.p99_us = value;
+        else if (key == "p999_us") r.p999_us = value;
+        else if (key == "max_us") r.max_us = value;
+        else if (key == "peak_rss_kb") r.peak_rss_kb = (long)value;
+    }
+    return true;
+}
+
+//Prints one row of the report. When a baseline is given, also prints how many times better current is than the
+//baseline: current/baseline for a metric where higher is better, baseline/current for one where lower is better.
+void PrintRow(const std::string& label, double value, const Results* baseline, double baseline_value,
+              bool lower_is_better) {
+    std::cout << "   " << std::left << std::setw(16) << label << std::right << std::setw(14) << std::fixed
+              << std::setprecision(2) << value;
+    if (baseline != nullptr && baseline_value > 0 && value > 0)
+        std::cout << std::setw(14) << baseline_value << std::setw(9)
+                  << (lower_is_better ? baseline_value / value : value / baseline_value) << "x";
+    std::cout << std::endl;
+}
+
+} //end BenchmarkNamespace
+
+int main(int argc, char* argv[]) {
+    using namespace BenchmarkNamespace;
+    int num_events = 200000;
+    unsigned seed = 1;
+    std::string mix_name = "balanced";
+    std::string config_name = "basic";
+    std::string page_table = "f";
+    int large_page_pages = 0;
+    int numa_nodes = 1;
+    std::string numa_policy = "f";
+    int io_batch = 1;
+    int cache_frames = 0;
+    std::string cache_policy = "l";
+    int async_depth = 0;
+    int SSD_channels = 0;
+    int aging_percent = 0;
+    int alarm_ms = 0;
+    int switch_us = 0;
+    std::string real_time_policy = "n";
+    bool threads = false;
+    int num_groups = 0;
+    int num_CPUs = 1;
+    std::string governor = "n";
+    int max_slowdown_percent = 20;
+    std::string save_file, baseline_file;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) num_events = atoi(argv[++i]);
+        else if (arg == "-s" && i + 1 < argc) seed = atoi(argv[++i]);
+        else if (arg == "-w" && i + 1 < argc) mix_name = argv[++i];
+        else if (arg == "-c" && i + 1 < argc) config_name = argv[++i];
+        else if (arg == "-t" && i + 1 < argc) page_table = argv[++i];
+        else if (arg == "-L" && i + 1 < argc) large_page_pages = atoi(argv[++i]);
+        else if (arg == "-N" && i + 1 < argc) numa_nodes = atoi(argv[++i]);
+        else if (arg == "-a" && i + 1 < argc) numa_policy = argv[++i];
+        else if (arg == "-b" && i + 1 < argc) io_batch = atoi(argv[++i]);
+        else if (arg == "-k" && i + 1 < argc) cache_frames = atoi(argv[++i]);
+        else if (arg == "-K" && i + 1 < argc) cache_policy = argv[++i];
+        else if (arg == "-A" && i + 1 < argc) async_depth = atoi(argv[++i]);
+        else if (arg == "-F" && i + 1 < argc) SSD_channels = atoi(argv[++i]);
+        else if (arg == "-g" && i + 1 < argc) aging_percent = atoi(argv[++i]);
+        else if (arg == "-G" && i + 1 < argc) alarm_ms = atoi(argv[++i]);
+        else if (arg == "-x" && i + 1 < argc) switch_us = atoi(argv[++i]);
+        else if (arg == "-R" && i + 1 < argc) real_time_policy = argv[++i];
+        else if (arg == "-T") threads = true;
+        else if (arg == "-P" && i + 1 < argc) num_groups = atoi(argv[++i]);
+        else if (arg == "-C" && i + 1 < argc) num_CPUs = atoi(argv[++i]);
+        else if (arg == "-E" && i + 1 < argc) governor = argv[++i];
+        else if (arg == "-e" && i + 1 < argc) max_slowdown_percent = atoi(argv[++i]);
+        else if (arg == "--save-baseline" && i + 1 < argc) save_file = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) baseline_file = argv[++i];
+        else if (arg == "-v") verbose = true;
+        else {
+            std::cout << "Usage: " << argv[0] << " [-n num_events] [-s seed] [-w balanced|io|memory] [-c basic|paging|pff|swap|cow] [-t f|2|3|h]"
+                      << " [-L large_page_pages] [-N numa_nodes] [-a f|i] [-b io_batch]"
+                      << " [-k cache_frames] [-K l|2|a] [-A async_depth] [-F SSD_channels] [-g aging_percent] [-G alarm_ms]"
+                      << " [-x switch_us] [-R e|r] [-T] [-P num_groups] [-C num_CPUs] [-E p|s|o|e] [-e max_slowdown_percent]"
+                      << " [--save-baseline file] [--baseline file] [-v]\n";
+            return 1;
+        }
+    }
+    const WorkloadMix* mix = nullptr;
+    for (size_t i = 0; i < sizeof(kMixes) / sizeof(kMixes[0]); ++i)
+        if (kMixes[i].name == mix_name) mix = &kMixes[i];
+    if (mix == nullptr) {
+        std::cout << "Unknown workload mix " << mix_name << ".\n";
+        return 1;
+    }
+    const SystemConfig* config = nullptr;
+    for (size_t i = 0; i < sizeof(kConfigs) / sizeof(kConfigs[0]); ++i)
+        if (kConfigs[i].name == config_name) config = &kConfigs[i];
+    if (config == nullptr) {
+        std::cout << "Unknown system configuration " << config_name << ".\n";
+        return 1;
+    }
+
+    /****WORKLOAD GENERATION******/
+    srand(seed);
+    std::vector<std::string> events;
+    events.reserve(num_events);
+    int num_arrivals = 0;
+    for (int i = 0; i < num_events; ++i)
+        events.push_back(MakeEvent(*mix, *config, async_depth > 0, SSD_channels > 0, real_time_policy != "n", threads, num_groups,
+                                   num_arrivals));
+    std::ostringstream usage_answers;
+    for (int i = 0; i < kUsageAnswers; ++i)
+        usage_answers << " " << RandomBetween(1, 20);
+
+    /****SYSTEM GENERATION******/
+    std::ostringstream sysgen;
+    sysgen << kTotalMemory << " " << kMaxProcessSize << " " << kPageSize << " " << config->memory_options << " ";
+    if (config->memory_options != "n") { //Last memory questions
+        sysgen << page_table << " " << large_page_pages << " " << numa_nodes << " ";
+        if (numa_nodes > 1) sysgen << numa_policy << " " << kLocalAccessNs << " " << kRemoteAccessNs << " ";
+    }
+    sysgen << kNumPrinters << " " << kNumDisks << " " << kNumCD_RW << " " << (SSD_channels > 0 ? kNumDisks : 0);
+    for (int i = 0; (SSD_channels > 0) && (i < kNumDisks); ++i) sysgen << " " << SSD_channels << " " << kSSDServiceUs;
+    sysgen << " 0.5 10";
+    for (int i = 0; i < kNumDisks; ++i) sysgen << " " << kNumCylinders;
+    if ( (io_batch > 1) || (cache_frames > 0) || (async_depth > 0) ) { //Advanced I/O options
+        sysgen << " y " << io_batch;
+        if (io_batch > 1) sysgen << " " << kMergeWindow;
+        sysgen << " " << async_depth << " " << cache_frames;
+        if (cache_frames > 0) sysgen << " " << cache_policy << " " << kFlushInterval;
+    } else
+        sysgen << " n";
+    if ( (aging_percent == 0) && (alarm_ms == 0) && (switch_us == 0)
+         && (real_time_policy == "n") && (num_groups == 0) && (num_CPUs <= 1)
+         && (governor == "n") ) //Advanced scheduling options
+        sysgen << " n";
+    else {
+        sysgen << " y " << aging_percent << " " << alarm_ms << " " << switch_us << " ";
+        if (switch_us > 0) sysgen << switch_us / 2 << " ";
+        sysgen << real_time_policy << " " << num_groups << " ";
+        for (int i = 1; i <= num_groups; ++i) sysgen << "0 " << kGroupFrames << " " << i << " " << kGroupIORate << " ";
+        sysgen << std::max(1, num_CPUs) << " ";
+        if (num_CPUs > 1) sysgen << (num_groups > 0 ? "g " : "t ");
+        sysgen << governor << " ";
+        if (governor == "e") sysgen << max_slowdown_percent;
+    }
+    std::istringstream sysgen_stream(sysgen.str());
+    NullBuffer null_buffer;
+    std::streambuf* cin_buffer = std::cin.rdbuf(sysgen_stream.rdbuf());
+    std::ios_base::fmtflags cout_flags = std::cout.flags();
+    std::streambuf* cout_buffer = verbose ? std::cout.rdbuf() : std::cout.rdbuf(&null_buffer);
+    Scheduler* my_system = new Scheduler;
+
+    /********RUNNING***********/
+    std::vector<double> latency_us;
+    latency_us.reserve(num_events);
+    EventBuffer event_buffer;
+    event_buffer.SetTail(usage_answers.str());
+    std::cin.rdbuf(&event_buffer);
+    std::string user_input;
+    auto run_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < events.size(); ++i) {
+        event_buffer.Load(events[i]);
+        std::cin.clear();
+        auto start = std::chrono::steady_clock::now();
+        std::cin >> user_input;
+        Dispatch(*my_system, user_input);
+        auto stop = std::chrono::steady_clock::now();
+        latency_us.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+    }
+    auto run_stop = std::chrono::steady_clock::now();
+    std::cin.rdbuf(cin_buffer);
+    std::cout.rdbuf(cout_buffer);
+    std::cout.flags(cout_flags); //Scheduler output leaves std::hex set
+    std::cin.clear();
+
+    /********REPORT***********/
+    Results results;
+    double seconds = std::chrono::duration<double>(run_stop - run_start).count();
+    std::sort(latency_us.begin(), latency_us.end());
+    results.events_per_sec = num_events / seconds;
+    results.p50_us = Percentile(latency_us, 0.50);
+    results.p90_us = Percentile(latency_us, 0.90);
+    results.p99_us = Percentile(latency_us, 0.99);
+    results.p999_us = Percentile(latency_us, 0.999);
+    results.max_us = latency_us.empty() ? 0.0 : latency_us.back();
+    results.peak_rss_kb = PeakRSS_KB();
+
+    Results baseline = Results();
+    const Results* have_baseline = nullptr;
+    if (!baseline_file.empty()) {
+        if (LoadBaseline(baseline_file, baseline)) have_baseline = &baseline;
+        else std::cout << "   Could not read baseline " << baseline_file << ". Reporting without comparison.\n";
+    }
+    std::cout << "Build: " << kBuild << std::endl;
+    std::cout << "Workload: " << mix->name << ", system " << config->name << ", page table " << page_table << ", large pages "
+              << large_page_pages << ", NUMA nodes " << numa_nodes << ", I/O batch "
+              << io_batch << ", buffer cache " << cache_frames << " " << cache_policy << ", async depth " << async_depth << ", SSD channels "
+              << SSD_channels << ", aging " << aging_percent << "%, switch " << switch_us << " us, real-time " << real_time_policy << ", "
+              << (threads ? "threads, " : "") << (num_groups > 0 ? std::to_string(num_groups) + " groups, " : "")
+              << (num_CPUs > 1 ? std::to_string(num_CPUs) + " CPUs, " : "")
+              << (governor != "n" ? "governor " + governor + ", " : "")
+              << num_events << " events, seed " << seed << std::endl;
+    std::cout << "   " << std::left << std::setw(16) << "Metric" << std::right << std::setw(14) << "Current";
+    if (have_baseline) std::cout << std::setw(14) << "Baseline" << std::setw(10) << "Better";
+    std::cout << std::endl;
+    PrintRow("events/sec", results.events_per_sec, have_baseline, baseline.events_per_sec, false);
+    PrintRow("p50 (us)", results.p50_us, have_baseline, baseline.p50_us, true);
+    PrintRow("p90 (us)", results.p90_us, have_baseline, baseline.p90_us, true);
+    PrintRow("p99 (us)", results.p99_us, have_baseline, baseline.p99_us, true);
+    PrintRow("p99.9 (us)", results.p999_us, have_baseline, baseline.p999_us, true);
+    PrintRow("max (us)", results.max_us, have_baseline, baseline.max_us, true);
+    PrintRow("peak RSS (KB)", results.peak_rss_kb, have_baseline, baseline.peak_rss_kb, true);
+    if (have_baseline)
+        std::cout << "   Better is how many times better than the baseline each metric is: above 1x is an improvement."
+                  << std::endl;
+    if (Instrumentation::Enabled())
+        Instrumentation::Report(std::cout);
+    if (my_system->MultiprocessorModel() != nullptr)
+        my_system->MultiprocessorModel()->Display(std::cout);
+    if (my_system->Energy() != nullptr)
+        my_system->Energy()->Display(std::cout);
+    if (!save_file.empty()) {
+        SaveBaseline(save_file, results);
+        std::cout << "Baseline saved to " << save_file << std::endl;
+    }
+    delete my_system;
+    return 0;
+}
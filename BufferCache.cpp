@@ -0,0 +1,186 @@
+#include "BufferCache.h"
+#include <algorithm>
+
+/********************BlockList********************/
+
+void BlockList::PushFront(const std::string& block) {
+    order_.push_front(block);
+    where_[block] = order_.begin();
+}
+
+void BlockList::Remove(const std::string& block) {
+    auto iter = where_.find(block);
+    if (iter == where_.end()) return;
+    order_.erase(iter->second);
+    where_.erase(iter);
+}
+
+void BlockList::MoveToFront(const std::string& block) {
+    auto iter = where_.find(block);
+    if (iter != where_.end()) order_.splice(order_.begin(), order_, iter->second);
+}
+
+std::string BlockList::PopBack() {
+    std::string block = order_.back();
+    where_.erase(block);
+    order_.pop_back();
+    return block;
+}
+
+/********************BufferCache********************/
+
+bool BufferCache::Read(const std::string& block) {
+    if ( Access(block) ) {
+        ++read_hits_;
+        return true;
+    }
+    ++read_misses_;
+    return false;
+}
+
+size_t BufferCache::Fill(const std::string& block) {
+    if ( Access(block) ) return 0; //Another request brought it in first.
+    std::vector<std::string> evicted;
+    Admit(block, evicted);
+    return WriteBack(evicted);
+}
+
+size_t BufferCache::Write(const std::string& block) {
+    ++writes_;
+    size_t written = 0;
+    if ( !Access(block) ) { //The whole block is written: nothing needs to be read first.
+        std::vector<std::string> evicted;
+        Admit(block, evicted);
+        written = WriteBack(evicted);
+    }
+    dirty_.insert(block);
+    return written;
+}
+
+size_t BufferCache::Flush() {
+    size_t written = dirty_.size();
+    dirty_.clear();
+    return written;
+}
+
+BufferCache* BufferCache::Create(char policy, size_t capacity) {
+    if (capacity == 0) capacity = 1;
+    switch (policy) {
+    case '2': return new TwoQueueBufferCache(capacity);
+    case 'a': return new ARCBufferCache(capacity);
+    default: return new LRUBufferCache(capacity);
+    }
+}
+
+size_t BufferCache::WriteBack(const std::vector<std::string>& evicted) {
+    size_t written = 0;
+    for (size_t i = 0; i < evicted.size(); ++i)
+        written += dirty_.erase(evicted[i]);
+    return written;
+}
+
+/********************LRUBufferCache********************/
+
+bool LRUBufferCache::Access(const std::string& block) {
+    if ( !blocks_.Contains(block) ) return false;
+    blocks_.MoveToFront(block);
+    return true;
+}
+
+void LRUBufferCache::Admit(const std::string& block, std::vector<std::string>& evicted) {
+    if (blocks_.Size() >= capacity_) evicted.push_back( blocks_.PopBack() );
+    blocks_.PushFront(block);
+}
+
+/********************TwoQueueBufferCache********************/
+
+TwoQueueBufferCache::TwoQueueBufferCache(size_t capacity) : BufferCache(capacity) {
+    kin_ = std::max<size_t>(1, capacity / 4);
+    kout_ = std::max<size_t>(1, capacity / 2);
+}
+
+bool TwoQueueBufferCache::Access(const std::string& block) {
+    if ( am_.Contains(block) ) {
+        am_.MoveToFront(block);
+        return true;
+    }
+    return a1in_.Contains(block); //A1in is FIFO: a hit there does not move the block.
+}
+
+void TwoQueueBufferCache::Admit(const std::string& block, std::vector<std::string>& evicted) {
+    Reclaim(evicted);
+    if ( a1out_.Contains(block) ) { //Referenced again soon after it left A1in: it is used often.
+        a1out_.Remove(block);
+        am_.PushFront(block);
+    } else
+        a1in_.PushFront(block);
+}
+
+void TwoQueueBufferCache::Reclaim(std::vector<std::string>& evicted) {
+    if (Size() < capacity_) return;
+    if ( (a1in_.Size() > kin_) || am_.Empty() ) {
+        std::string block = a1in_.PopBack();
+        evicted.push_back(block);
+        a1out_.PushFront(block);
+        if (a1out_.Size() > kout_) a1out_.PopBack();
+    } else
+        evicted.push_back( am_.PopBack() );
+}
+
+/********************ARCBufferCache********************/
+
+bool ARCBufferCache::Access(const std::string& block) {
+    if ( t1_.Contains(block) ) {
+        t1_.Remove(block);
+        t2_.PushFront(block);
+        return true;
+    }
+    if ( !t2_.Contains(block) ) return false;
+    t2_.MoveToFront(block);
+    return true;
+}
+
+void ARCBufferCache::Admit(const std::string& block, std::vector<std::string>& evicted) {
+    double capacity = capacity_;
+    if ( b1_.Contains(block) ) { //Recency would have hit: give T1 more room.
+        target_t1_ = std::min(capacity, target_t1_ + std::max(1.0, double(b2_.Size()) / b1_.Size()));
+        if (Size() >= capacity_) Replace(false, evicted);
+        b1_.Remove(block);
+        t2_.PushFront(block);
+        return;
+    }
+    if ( b2_.Contains(block) ) { //Frequency would have hit: give T2 more room.
+        target_t1_ = std::max(0.0, target_t1_ - std::max(1.0, double(b1_.Size()) / b2_.Size()));
+        if (Size() >= capacity_) Replace(true, evicted);
+        b2_.Remove(block);
+        t2_.PushFront(block);
+        return;
+    }
+    size_t l1 = t1_.Size() + b1_.Size();
+    size_t total = l1 + t2_.Size() + b2_.Size();
+    if (l1 >= capacity_) {
+        if (t1_.Size() < capacity_) {
+            b1_.PopBack();
+            if (Size() >= capacity_) Replace(false, evicted);
+        } else
+            evicted.push_back( t1_.PopBack() ); //B1 is empty: the block is dropped, not remembered.
+    } else if (total >= capacity_) {
+        if ( (total >= 2 * capacity_) && !b2_.Empty() ) b2_.PopBack();
+        if (Size() >= capacity_) Replace(false, evicted);
+    }
+    t1_.PushFront(block);
+}
+
+void ARCBufferCache::Replace(bool in_b2, std::vector<std::string>& evicted) {
+    bool from_t1 = !t1_.Empty() && ( (in_b2 && (t1_.Size() == (size_t)target_t1_)) || (t1_.Size() > target_t1_) );
+    if (t2_.Empty()) from_t1 = true;
+    if (from_t1) {
+        std::string block = t1_.PopBack();
+        evicted.push_back(block);
+        b1_.PushFront(block);
+    } else {
+        std::string block = t2_.PopBack();
+        evicted.push_back(block);
+        b2_.PushFront(block);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Author: Emma Kimlin
+ * Title: BufferCache.h
+ * Date Created: 10.18.2026
+ * Description: Block buffer cache between processes and the disks. Reads that hit are served without going to a disk;
+ *              writes are absorbed (write-back) and reach the disk only when a dirty block is evicted or flushed.
+ *              Replacement policies:
+ *              LRU: evicts the least recently used block.
+ *              2Q: new blocks enter a FIFO (A1in); a block referenced again after it left A1in (remembered in the
+ *              A1out ghost list) goes to an LRU list (Am). One-time scans do not push out the blocks used often.
+ *              ARC: balances a recency list (T1) and a frequency list (T2), moving the target size of T1 with hits
+ *              in the ghost lists of blocks recently evicted from each (B1, B2).
+*/
+
+#ifndef BufferCache_h
+#define BufferCache_h
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/* Blocks in recency order, most recent first, with constant time lookup and removal. */
+class BlockList {
+public:
+    bool Contains(const std::string& block) const { return where_.count(block) > 0; }
+    size_t Size() const { return order_.size(); }
+    bool Empty() const { return order_.empty(); }
+    void PushFront(const std::string& block);
+    void Remove(const std::string& block);
+    void MoveToFront(const std::string& block);
+    /* Removes and returns the least recent block. Pre-Condition: !Empty(). */
+    std::string PopBack();
+private:
+    std::list<std::string> order_;
+    std::unordered_map<std::string, std::list<std::string>::iterator> where_;
+};
+
+class BufferCache {
+public:
+    virtual ~BufferCache() {}
+
+    /* Reads block. Returns true if the cache holds it (a hit); a miss must be read from the disk. */
+    bool Read(const std::string& block);
+    /* block was read from the disk: caches it. Returns the dirty blocks written back to make room. */
+    size_t Fill(const std::string& block);
+    /* Writes block into the cache, which holds it dirty. Returns the dirty blocks written back to make room. */
+    size_t Write(const std::string& block);
+    /* Writes every dirty block back to the disk. Returns how many were written. */
+    size_t Flush();
+
+    size_t Capacity() const { return capacity_; }
+    virtual size_t Size() const = 0;
+    size_t DirtyBlocks() const { return dirty_.size(); }
+    unsigned long ReadHits() const { return read_hits_; }
+    unsigned long ReadMisses() const { return read_misses_; }
+    unsigned long Writes() const { return writes_; }
+    virtual const char* Name() const = 0;
+
+    /* policy: 'l' LRU, '2' 2Q, 'a' ARC. capacity is in blocks, at least one. */
+    static BufferCache* Create(char policy, size_t capacity);
+
+protected:
+    explicit BufferCache(size_t capacity) : capacity_(capacity), read_hits_(0), read_misses_(0), writes_(0) {}
+    /* If block is cached, records the reference by the policy and returns true. */
+    virtual bool Access(const std::string& block) = 0;
+    /* Caches block, appending the blocks evicted to make room to evicted. Pre-Condition: block is not cached. */
+    virtual void Admit(const std::string& block, std::vector<std::string>& evicted) = 0;
+
+    size_t capacity_;
+
+private:
+    /* Forgets the evicted blocks. Returns how many were dirty and so written back. */
+    size_t WriteBack(const std::vector<std::string>& evicted);
+
+    std::unordered_set<std::string> dirty_;
+    unsigned long read_hits_;
+    unsigned long read_misses_;
+    unsigned long writes_;
+};
+
+class LRUBufferCache : public BufferCache {
+public:
+    explicit LRUBufferCache(size_t capacity) : BufferCache(capacity) {}
+    size_t Size() const { return blocks_.Size(); }
+    const char* Name() const { return "LRU"; }
+protected:
+    bool Access(const std::string& block);
+    void Admit(const std::string& block, std::vector<std::string>& evicted);
+private:
+    BlockList blocks_;
+};
+
+class TwoQueueBufferCache : public BufferCache {
+public:
+    /* A1in holds a quarter of the blocks; A1out remembers half as many blocks as the cache holds. */
+    explicit TwoQueueBufferCache(size_t capacity);
+    size_t Size() const { return a1in_.Size() + am_.Size(); }
+    const char* Name() const { return "2Q"; }
+protected:
+    bool Access(const std::string& block);
+    void Admit(const std::string& block, std::vector<std::string>& evicted);
+private:
+    /* Evicts a block if the cache is full. */
+    void Reclaim(std::vector<std::string>& evicted);
+
+    size_t kin_;
+    size_t kout_;
+    BlockList a1in_; //seen once, FIFO
+    BlockList a1out_; //ghosts: evicted from a1in_, not cached
+    BlockList am_; //seen again, LRU
+};
+
+class ARCBufferCache : public BufferCache {
+public:
+    explicit ARCBufferCache(size_t capacity) : BufferCache(capacity), target_t1_(0.0) {}
+    size_t Size() const { return t1_.Size() + t2_.Size(); }
+    const char* Name() const { return "ARC"; }
+protected:
+    bool Access(const std::string& block);
+    void Admit(const std::string& block, std::vector<std::string>& evicted);
+private:
+    /* Evicts the LRU block of T1 or T2 into its ghost list, by the target size of T1. */
+    void Replace(bool in_b2, std::vector<std::string>& evicted);
+
+    double target_t1_; //p: target size of T1
+    BlockList t1_; //cached, seen once recently
+    BlockList t2_; //cached, seen at least twice recently
+    BlockList b1_; //ghosts evicted from T1
+    BlockList b2_; //ghosts evicted from T2
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "Device.h"
+#include <cctype>
+#include <functional>
+
+namespace DeviceNamespace {
+
+//Indexed by DeviceKind.
+const DeviceClass kClasses[kNumDeviceKinds] = {
+    //name      plural           letter r/w    cylinders cached
+    { "printer", "printers",      'p', false, false,    false },
+    { "disk",    "disks",         'd', true,  true,     true  },
+    { "CD_RW",   "CD_RW devices", 'c', true,  false,    false },
+    { "SSD",     "SSDs",          'n', true,  false,    false },
+};
+
+} //end DeviceNamespace
+
+/********************Device********************/
+
+Device::Device(DeviceKind kind, int number, int num_queues, int service_time_us)
+    : queues_(num_queues), kind_(kind), number_(number), num_cylinders_(0), service_time_us_(service_time_us) {}
+
+bool Device::Idle() const {
+    for (size_t i = 0; i < queues_.size(); ++i)
+        if ( !queues_[i].empty() ) return false;
+    return true;
+}
+
+const DeviceClass& Device::Classes(DeviceKind kind) {
+    return DeviceNamespace::kClasses[kind];
+}
+
+DeviceKind Device::KindOfLetter(char letter) {
+    letter = std::tolower(letter);
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind)
+        if (DeviceNamespace::kClasses[kind].letter == letter) return DeviceKind(kind);
+    return kNumDeviceKinds;
+}
+
+Device* Device::CreateFIFO(DeviceKind kind, int number) {
+    return new FIFODevice(kind, number);
+}
+
+Device* Device::CreateChannels(DeviceKind kind, int number, int num_channels, int service_time_us) {
+    return new ChannelDevice(kind, number, num_channels, service_time_us);
+}
+
+/********************ChannelDevice********************/
+
+void ChannelDevice::Submit(const PCB& request) {
+    size_t channel = std::hash<int>()( request.getFile() ) % queues_.size();
+    queues_[channel].push_back(request);
+}
@@ -0,0 +1,87 @@
+/*
+ * Author: Emma Kimlin
+ * Title: Device.h
+ * Date Created: 10.18.2026
+ * Description: I/O devices the Scheduler sends requests to. Each device class has a table entry giving its name, the
+ *              letters of its commands and which questions a request asks, so the Scheduler looks up classes by index
+ *              instead of comparing names. Each device holds the requests it has not completed, by its own discipline:
+ *              FIFO: one queue served one request at a time (printers, disks, CD_RW devices).
+ *              Channels: several queues served in parallel, a request going to the channel its file is stored on (SSDs).
+*/
+
+#ifndef Device_h
+#define Device_h
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "PCB.h"
+
+enum DeviceKind { kPrinter, kDisk, kCD_RW, kSSD, kNumDeviceKinds };
+
+/* What sets a class of devices apart, for commands and system calls. */
+struct DeviceClass {
+    const char* name; //singular, as shown in messages
+    const char* plural; //as asked at system generation
+    char letter; //system call; the upper case letter is the interrupt
+    bool read_write; //a request asks read or write; if not it writes
+    bool cylinders; //a request asks for a cylinder, and requests merge only on nearby cylinders
+    bool cached; //requests go through the buffer cache
+};
+
+class Device {
+public:
+    virtual ~Device() {}
+
+    /* Queues request by the device's discipline. */
+    virtual void Submit(const PCB& request) = 0;
+
+    /* The queues the device serves in parallel, each first come first served. */
+    std::vector<std::deque<PCB> >& Queues() { return queues_; }
+    const std::vector<std::deque<PCB> >& Queues() const { return queues_; }
+    /* True if no queue holds a request. */
+    bool Idle() const;
+
+    DeviceKind Kind() const { return kind_; }
+    const DeviceClass& Class() const { return Classes(kind_); }
+    /* Number of the device among those of its class, from 1. */
+    int Number() const { return number_; }
+    int NumCylinders() const { return num_cylinders_; }
+    void setNumCylinders(int num_cylinders) { num_cylinders_ = num_cylinders; }
+    /* Time one queue takes to serve a request, in microseconds; 0 if not modeled. */
+    int ServiceTimeUs() const { return service_time_us_; }
+
+    static const DeviceClass& Classes(DeviceKind kind);
+    /* Class whose system call (lower case) or interrupt (upper case) letter is letter. Returns kNumDeviceKinds if none. */
+    static DeviceKind KindOfLetter(char letter);
+    /* A device served one request at a time. */
+    static Device* CreateFIFO(DeviceKind kind, int number);
+    /* A device with num_channels queues served in parallel, each taking service_time_us per request. */
+    static Device* CreateChannels(DeviceKind kind, int number, int num_channels, int service_time_us);
+
+protected:
+    Device(DeviceKind kind, int number, int num_queues, int service_time_us);
+
+    std::vector<std::deque<PCB> > queues_;
+
+private:
+    DeviceKind kind_;
+    int number_;
+    int num_cylinders_;
+    int service_time_us_;
+};
+
+class FIFODevice : public Device {
+public:
+    FIFODevice(DeviceKind kind, int number) : Device(kind, number, 1, 0) {}
+    void Submit(const PCB& request) { queues_[0].push_back(request); }
+};
+
+class ChannelDevice : public Device {
+public:
+    ChannelDevice(DeviceKind kind, int number, int num_channels, int service_time_us)
+        : Device(kind, number, num_channels, service_time_us) {}
+    void Submit(const PCB& request);
+};
+
+#endif
@@ -0,0 +1,270 @@
+#include "Energy.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+/********************Utility Functions********************/
+namespace EnergyNamespace {
+
+struct PState {
+    int MHz;
+    double watts; //drawn while running
+};
+
+struct CState {
+    const char* name;
+    double watts; //drawn while asleep
+    double exit_ms; //time to wake
+    double residency_ms; //shortest sleep that saves energy over the shallowest state, entering and leaving included
+};
+
+struct DevicePower {
+    double active_watts; //while serving a request
+    double idle_watts;
+    double service_ms; //time to serve a request, for devices that do not give their own
+};
+
+//P-states, top frequency first. The power is the dynamic power of the voltage each frequency needs, plus leakage.
+const PState kPStates[EnergyModel::kNumPStates] = {
+    { 2800, 10.5 }, { 2400, 7.4 }, { 2000, 5.2 }, { 1600, 3.6 }, { 1200, 2.4 }, { 800, 1.6 }
+};
+
+//C-states, shallowest first.
+const CState kCStates[EnergyModel::kNumCStates] = {
+    { "C1", 1.0, 0.002, 0.002 },
+    { "C3", 0.3, 0.08, 0.4 },
+    { "C6", 0.05, 0.3, 2.0 }
+};
+
+//Indexed by DeviceKind.
+const DevicePower kDevicePower[kNumDeviceKinds] = {
+    { 12.0, 2.0, 40.0 }, //printer
+    { 7.0, 2.5, 8.0 }, //disk
+    { 5.0, 1.0, 60.0 }, //CD_RW
+    { 3.0, 0.05, 0.1 } //SSD
+};
+
+const double kPStateSwitchMs = 0.01; //The CPU stalls while the voltage and frequency change.
+const double kUpThreshold = 0.8; //Share of the time busy the ondemand governor keeps the CPU at
+
+const int kTop = 0;
+const int kLowest = EnergyModel::kNumPStates - 1;
+
+//Joules drawn at watts for ms.
+double JoulesAt(double watts, double ms) { return watts * ms / 1000.0; }
+
+//Energy entering C-state c costs: what makes sleeping in it for its target residency break even with the shallowest.
+double EntryJoules(int c) { return JoulesAt(kCStates[0].watts - kCStates[c].watts, kCStates[c].residency_ms); }
+
+//Time work_ms of CPU time at the top frequency takes in P-state p.
+double RunMs(int p, double work_ms) { return work_ms * kPStates[kTop].MHz / kPStates[p].MHz; }
+
+} //end EnergyNamespace
+
+/********************Public Member Functions********************/
+
+EnergyModel::EnergyModel(char governor, int max_slowdown_percent)
+    : governor_(governor), max_slowdown_(max_slowdown_percent / 100.0), now_ms_(0.0), pstate_(EnergyNamespace::kTop),
+      cstate_(-1), idle_since_(0.0), predicted_idle_ms_(0.0), busy_since_decision_(0.0), idle_since_decision_(0.0),
+      pstate_switches_(0), work_ms_(0.0), wake_ms_(0.0), switch_ms_(0.0), active_joules_(0.0), idle_joules_(0.0),
+      jobs_(0), job_joules_(0.0) {
+    for (int p = 0; p < kNumPStates; ++p)
+        pstate_ms_[p] = 0.0;
+    for (int c = 0; c < kNumCStates; ++c) {
+        cstate_ms_[c] = 0.0;
+        cstate_entries_[c] = 0;
+        cstate_too_short_[c] = 0;
+    }
+}
+
+void EnergyModel::AddDevice(int id, DeviceKind kind, int number, int service_us) {
+    DeviceEnergy device = { kind, number, EnergyNamespace::kDevicePower[kind].service_ms, 0, 0.0 };
+    if (service_us > 0) device.service_ms = service_us / 1000.0;
+    devices_[id] = device;
+}
+
+void EnergyModel::EnterIdle() {
+    if (cstate_ >= 0) return;
+    cstate_ = ChooseCState();
+    ++cstate_entries_[cstate_];
+    idle_joules_ += EnergyNamespace::EntryJoules(cstate_);
+    idle_since_ = now_ms_;
+}
+
+void EnergyModel::Idle(double ms) {
+    if (ms <= 0) return;
+    EnterIdle();
+    now_ms_ += ms;
+    cstate_ms_[cstate_] += ms;
+    idle_joules_ += EnergyNamespace::JoulesAt(EnergyNamespace::kCStates[cstate_].watts, ms);
+    idle_since_decision_ += ms;
+}
+
+void EnergyModel::Dispatch(double expected_ms, bool real_time) {
+    if (cstate_ >= 0) Wake();
+    SetPState( ChoosePState(expected_ms, real_time) );
+}
+
+void EnergyModel::Run(int PID, double work_ms) {
+    if (cstate_ >= 0) Wake();
+    double ms = EnergyNamespace::RunMs(pstate_, work_ms);
+    double joules = EnergyNamespace::JoulesAt(EnergyNamespace::kPStates[pstate_].watts, ms);
+    now_ms_ += ms;
+    pstate_ms_[pstate_] += ms;
+    work_ms_ += work_ms;
+    busy_since_decision_ += ms;
+    active_joules_ += joules;
+    process_joules_[PID] += joules;
+}
+
+double EnergyModel::ServiceMs(int id) const {
+    auto device = devices_.find(id);
+    return (device == devices_.end()) ? 0.0 : device->second.service_ms;
+}
+
+void EnergyModel::Serve(int id, int PID) {
+    auto device = devices_.find(id);
+    if ( device == devices_.end() ) return;
+    ++device->second.requests;
+    device->second.busy_ms += device->second.service_ms;
+    process_joules_[PID] += EnergyNamespace::JoulesAt(EnergyNamespace::kDevicePower[device->second.kind].active_watts,
+                                                      device->second.service_ms);
+}
+
+void EnergyModel::CompleteJob(int PID) {
+    ++jobs_;
+    auto process = process_joules_.find(PID);
+    if ( process == process_joules_.end() ) return;
+    job_joules_ += process->second;
+    process_joules_.erase(process);
+}
+
+double EnergyModel::Joules() const {
+    double joules = active_joules_ + idle_joules_;
+    for (auto iter = devices_.begin(); iter != devices_.end(); ++iter) {
+        const EnergyNamespace::DevicePower& power = EnergyNamespace::kDevicePower[iter->second.kind];
+        joules += EnergyNamespace::JoulesAt(power.active_watts, iter->second.busy_ms)
+                + EnergyNamespace::JoulesAt(power.idle_watts, std::max(0.0, now_ms_ - iter->second.busy_ms));
+    }
+    return joules;
+}
+
+void EnergyModel::Display(std::ostream& out) const {
+    using namespace EnergyNamespace;
+    const char* governor = "energy-aware";
+    if (governor_ == 'p') governor = "performance";
+    else if (governor_ == 's') governor = "powersave";
+    else if (governor_ == 'o') governor = "ondemand";
+    out << "   Energy model: " << governor << " governor";
+    if (governor_ == 'e')
+        out << ", slowing bursts down by at most " << std::dec << int(100 * max_slowdown_ + 0.5) << "%";
+    out << ".  Time: " << now_ms_ << " ms  Energy: " << Joules() << " J\n";
+    double run_ms = 0.0, idle_ms = 0.0;
+    out << "P-state|" << std::setw(6) << "MHz|" << std::setw(8) << "Watts|" << std::setw(12) << "Run ms" << std::endl;
+    for (int p = 0; p < kNumPStates; ++p) {
+        out << std::setw(6) << "P" << p << std::setw(6) << kPStates[p].MHz << std::setw(8) << kPStates[p].watts
+            << std::setw(12) << pstate_ms_[p] << std::endl;
+        run_ms += pstate_ms_[p];
+    }
+    out << "C-state|" << std::setw(8) << "Watts|" << std::setw(9) << "Exit us|" << std::setw(14) << "Residency us|"
+        << std::setw(9) << "Entries|" << std::setw(11) << "Too Short|" << std::setw(12) << "Idle ms" << std::endl;
+    for (int c = 0; c < kNumCStates; ++c) {
+        out << std::setw(7) << kCStates[c].name << std::setw(8) << kCStates[c].watts << std::setw(9)
+            << 1000 * kCStates[c].exit_ms << std::setw(14) << 1000 * kCStates[c].residency_ms << std::setw(9)
+            << cstate_entries_[c] << std::setw(11) << cstate_too_short_[c] << std::setw(12) << cstate_ms_[c]
+            << std::endl;
+        idle_ms += cstate_ms_[c];
+    }
+    out << "   CPU time entered: " << work_ms_ << " ms, run in " << run_ms << " ms (slowed down by "
+        << (work_ms_ > 0 ? 100.0 * (run_ms - work_ms_) / work_ms_ : 0.0) << "%)  Idle: " << idle_ms << " ms\n"
+        << "   Waking: " << wake_ms_ << " ms  Switching P-states: " << switch_ms_ << " ms (" << pstate_switches_
+        << " switches)\n   CPU energy: " << active_joules_ + idle_joules_ << " J (" << active_joules_ << " J running, "
+        << idle_joules_ << " J idle)\n";
+    if ( !devices_.empty() )
+        out << " Device|" << std::setw(11) << "Requests|" << std::setw(10) << "Busy ms|" << std::setw(12) << "Active J|"
+            << std::setw(10) << "Idle J" << std::endl;
+    for (auto iter = devices_.begin(); iter != devices_.end(); ++iter) {
+        const DeviceEnergy& device = iter->second;
+        const DevicePower& power = kDevicePower[device.kind];
+        out << std::setw(6) << Device::Classes(device.kind).letter << device.number << std::setw(11) << device.requests
+            << std::setw(10) << device.busy_ms << std::setw(12) << JoulesAt(power.active_watts, device.busy_ms)
+            << std::setw(10) << JoulesAt(power.idle_watts, std::max(0.0, now_ms_ - device.busy_ms)) << std::endl;
+    }
+    out << "   Jobs: " << jobs_ << "  Jobs per second: " << (now_ms_ > 0 ? 1000.0 * jobs_ / now_ms_ : 0.0)
+        << "  Joules per job: ";
+    if (jobs_ == 0) out << "None";
+    else out << job_joules_ / jobs_ << " of its own CPU time and I/O, " << Joules() / jobs_ << " of the whole system";
+    out << std::endl << "   Most energy among processes in the system: ";
+    std::vector< std::pair<double, int> > processes;
+    for (auto iter = process_joules_.begin(); iter != process_joules_.end(); ++iter)
+        processes.push_back( std::make_pair(iter->second, iter->first) );
+    std::sort( processes.rbegin(), processes.rend() );
+    if ( processes.empty() ) out << "None";
+    for (size_t i = 0; (i < processes.size()) && (i < 5); ++i)
+        out << "P" << processes[i].second << " (" << processes[i].first << " J) ";
+    out << std::endl;
+}
+
+/********************Private Member Functions********************/
+
+int EnergyModel::ChoosePState(double expected_ms, bool real_time) {
+    using namespace EnergyNamespace;
+    double busy = busy_since_decision_, total = busy_since_decision_ + idle_since_decision_;
+    busy_since_decision_ = 0.0;
+    idle_since_decision_ = 0.0;
+    if ( (governor_ == 'p') || real_time ) return kTop;
+    if (governor_ == 's') return kLowest;
+    if (governor_ == 'o') {
+        if (total == 0) return pstate_;
+        double MHz = kPStates[kTop].MHz * (busy / total) / kUpThreshold;
+        int pstate = kLowest;
+        while ( (pstate > kTop) && (kPStates[pstate].MHz < MHz) ) --pstate;
+        return pstate;
+    }
+    //Energy-aware: run the burst, then sleep until the lowest frequency would have finished it (race to idle).
+    double window_ms = RunMs(kLowest, expected_ms) + kPStateSwitchMs;
+    double idle_watts = kCStates[ ChooseCState() ].watts;
+    int best = kTop;
+    double least_joules = std::numeric_limits<double>::max();
+    for (int p = kTop; p < kNumPStates; ++p) {
+        double switch_ms = (p == pstate_) ? 0.0 : kPStateSwitchMs;
+        double ms = RunMs(p, expected_ms) + switch_ms;
+        if ( (p != kTop) && (ms > expected_ms * (1.0 + max_slowdown_)) ) continue;
+        double joules = JoulesAt(kPStates[p].watts, ms) + JoulesAt( idle_watts, std::max(0.0, window_ms - ms) );
+        if (joules < least_joules) {
+            best = p;
+            least_joules = joules;
+        }
+    }
+    return best;
+}
+
+int EnergyModel::ChooseCState() const {
+    if (governor_ == 'p') return 0;
+    if (governor_ == 's') return kNumCStates - 1;
+    int cstate = kNumCStates - 1; //The deepest the predicted idle period is long enough for.
+    while ( (cstate > 0) && (EnergyNamespace::kCStates[cstate].residency_ms > predicted_idle_ms_) ) --cstate;
+    return cstate;
+}
+
+void EnergyModel::SetPState(int pstate) {
+    if (pstate == pstate_) return;
+    double watts = std::max(EnergyNamespace::kPStates[pstate].watts, EnergyNamespace::kPStates[pstate_].watts);
+    ++pstate_switches_;
+    now_ms_ += EnergyNamespace::kPStateSwitchMs;
+    switch_ms_ += EnergyNamespace::kPStateSwitchMs;
+    active_joules_ += EnergyNamespace::JoulesAt(watts, EnergyNamespace::kPStateSwitchMs);
+    pstate_ = pstate;
+}
+
+void EnergyModel::Wake() {
+    const EnergyNamespace::CState& state = EnergyNamespace::kCStates[cstate_];
+    double idle_ms = now_ms_ - idle_since_;
+    if (idle_ms < state.residency_ms) ++cstate_too_short_[cstate_];
+    predicted_idle_ms_ = (predicted_idle_ms_ + idle_ms) / 2;
+    now_ms_ += state.exit_ms;
+    wake_ms_ += state.exit_ms;
+    active_joules_ += EnergyNamespace::JoulesAt(EnergyNamespace::kPStates[pstate_].watts, state.exit_ms);
+    cstate_ = -1;
+}
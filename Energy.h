@@ -0,0 +1,120 @@
+/*
+ * Author: Emma Kimlin
+ * Title: Energy.h
+ * Date Created: 10.18.2026
+ * Description: Energy used by the CPU and the devices. The CPU runs in one of several P-states (a frequency and the
+ *              power drawn at it) and sleeps in one of several C-states while idle, each deeper state drawing less
+ *              power but taking longer to wake from and costing more to enter. A governor picks the P-state whenever
+ *              a process is placed in the CPU and the C-state whenever the CPU runs out of processes:
+ *              performance: the top frequency, and only the shallowest C-state, for the least delay.
+ *              powersave: the lowest frequency and the deepest C-state, for the least power.
+ *              ondemand: the lowest frequency that would have kept the CPU 80% busy since the last decision, and the
+ *              deepest C-state worth entering for the idle period predicted from the last ones.
+ *              energy-aware: the frequency that runs the expected burst, then idles until the lowest frequency would
+ *              have finished it, on the least energy, without slowing the burst down by more than a given percent.
+ *              Real-time tasks run at the top frequency. C-states are picked as by ondemand.
+ *              The CPU time entered for a burst is the time it takes at the top frequency; it takes longer at a lower
+ *              one, and the model keeps its own clock of the time that passes. The CPU is idle while it waits for a
+ *              device to serve a request or for a group's I/O limit. Every device draws its active power for the
+ *              time it serves a request and its idle power otherwise. The energy of a burst and of the requests
+ *              served is charged to the process, and counted for its job when it leaves the system.
+*/
+
+#ifndef Energy_h
+#define Energy_h
+
+#include <iostream>
+#include <map>
+#include "Device.h"
+
+class EnergyModel {
+public:
+    static const int kNumPStates = 6;
+    static const int kNumCStates = 3;
+
+    /**
+      * governor is 'p' performance, 's' powersave, 'o' ondemand or 'e' energy-aware. max_slowdown_percent is the most
+      * the energy-aware governor may slow a burst down by.
+     */
+    EnergyModel(char governor, int max_slowdown_percent);
+
+    /* Device number of class kind, told apart from the others by id, is in the system. service_us is the time it
+       takes to serve a request, or 0 for that of its class. */
+    void AddDevice(int id, DeviceKind kind, int number, int service_us);
+
+    /* The CPU has run out of processes: the governor puts it in a C-state. Nothing changes if it is already idle. */
+    void EnterIdle();
+    /* ms pass with the CPU idle. */
+    void Idle(double ms);
+    /**
+      * A process expected to run expected_ms of CPU time (at the top frequency) is placed in the CPU. The CPU wakes
+      * if it was idle, and the governor sets its P-state.
+     */
+    void Dispatch(double expected_ms, bool real_time);
+    /* Process PID ran work_ms of CPU time, which takes work_ms at the top frequency and longer at a lower one. */
+    void Run(int PID, double work_ms);
+
+    /* Time device id takes to serve a request, in ms. */
+    double ServiceMs(int id) const;
+    /* Device id has served a request of process PID. */
+    void Serve(int id, int PID);
+
+    /* Process PID has left the system. The energy charged to it counts as one job's. */
+    void CompleteJob(int PID);
+
+    /* Energy used so far by the CPU and the devices, in joules. */
+    double Joules() const;
+    /* Time passed in the model so far, in ms. */
+    double WallMs() const { return now_ms_; }
+
+    /**
+      * Prints the governor, the time spent in every P-state and C-state, the energy of the CPU and of every device,
+      * and the joules per job alongside the jobs completed per second.
+     */
+    void Display(std::ostream& out) const;
+
+private:
+    /* A device and the time it has served requests. */
+    struct DeviceEnergy {
+        DeviceKind kind;
+        int number;
+        double service_ms;
+        unsigned long requests;
+        double busy_ms;
+    };
+
+    /* P-state the governor runs a burst expected to take expected_ms in. */
+    int ChoosePState(double expected_ms, bool real_time);
+    /* C-state the governor puts the idle CPU in. */
+    int ChooseCState() const;
+    /* Sets the P-state, paying for the switch if it changes. */
+    void SetPState(int pstate);
+    /* Wakes the CPU from its C-state. */
+    void Wake();
+
+    char governor_;
+    double max_slowdown_; //fraction a burst may be slowed down by under the energy-aware governor
+    double now_ms_;
+    int pstate_;
+    int cstate_; //C-state of the idle CPU; -1 while it is running
+    double idle_since_;
+    double predicted_idle_ms_; //idle period the C-state is picked for: a running average of the last ones
+    double busy_since_decision_; //ms run and idled since the ondemand governor last picked a P-state
+    double idle_since_decision_;
+    double pstate_ms_[kNumPStates]; //time run in each P-state
+    double cstate_ms_[kNumCStates]; //time idle in each C-state
+    unsigned long cstate_entries_[kNumCStates];
+    unsigned long cstate_too_short_[kNumCStates]; //idle periods shorter than the state's target residency
+    unsigned long pstate_switches_;
+    double work_ms_; //CPU time entered for the bursts run
+    double wake_ms_; //time spent waking from C-states
+    double switch_ms_; //time spent switching P-states
+    double active_joules_; //running bursts, waking and switching
+    double idle_joules_; //sleeping, and entering C-states
+    std::map<int, DeviceEnergy> devices_; //Key is id.
+    std::map<int, double> process_joules_; //Key is PID. Energy charged to processes still in the system.
+    unsigned long jobs_;
+    double job_joules_; //energy charged to the jobs completed
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "FileTable.h"
+#include <iomanip>
+#include <iostream>
+
+namespace FileTableNamespace {
+
+const std::string kNoFileName = "--";
+
+} //end FileTableNamespace
+
+int FileTable::Intern(const std::string& name) {
+    auto iter = numbers_.find(name);
+    if (iter != numbers_.end()) return iter->second;
+    FileInfo info = { name, 0, 0, 0, 0, 0 };
+    files_.push_back(info);
+    numbers_[name] = files_.size() - 1;
+    return files_.size() - 1;
+}
+
+const std::string& FileTable::Name(int file) const {
+    if (file == kNoFile) return FileTableNamespace::kNoFileName;
+    return files_[file].name;
+}
+
+void FileTable::Open(int file) {
+    if (file == kNoFile) return;
+    if (files_[file].open_requests++ == 0) ++open_files_;
+}
+
+void FileTable::Close(int file) {
+    if ( (file == kNoFile) || (files_[file].open_requests == 0) ) return;
+    if (--files_[file].open_requests == 0) --open_files_;
+}
+
+void FileTable::CountIO(int file, char read_write, int bytes) {
+    if (file == kNoFile) return;
+    FileInfo& info = files_[file];
+    if (read_write == 'r') {
+        ++info.reads;
+        info.bytes_read += bytes;
+    } else {
+        ++info.writes;
+        info.bytes_written += bytes;
+    }
+}
+
+void FileTable::Display(std::ostream& out) const {
+    out << "   Files: " << std::dec << files_.size() << "  Open: " << open_files_ << std::endl;
+    if ( files_.empty() ) return;
+    out << std::setw(12) << "Filename|" << std::setw(6) << "Open|" << std::setw(7) << "Reads|" << std::setw(12)
+        << "Bytes Read|" << std::setw(8) << "Writes|" << std::setw(15) << "Bytes Written" << std::endl;
+    for (size_t i = 0; i < files_.size(); ++i)
+        out << std::setw(11) << files_[i].name << std::setw(6) << files_[i].open_requests << std::setw(7)
+            << files_[i].reads << std::setw(12) << files_[i].bytes_read << std::setw(8) << files_[i].writes
+            << std::setw(15) << files_[i].bytes_written << std::endl;
+}
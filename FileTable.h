@@ -0,0 +1,59 @@
+/*
+ * Author: Emma Kimlin
+ * Title: FileTable.h
+ * Date Created: 10.18.2026
+ * Description: System-wide table of the files named by I/O requests. A file name is interned once, when a request
+ *              first names it; requests then carry the file's number, so device queues, merging and the buffer cache
+ *              compare numbers instead of names. A file is open while requests for it wait at devices. The table
+ *              counts the requests and bytes read and written of every file.
+*/
+
+#ifndef FileTable_h
+#define FileTable_h
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FileTable {
+public:
+    static const int kNoFile = -1; //A request that names no file
+
+    FileTable() : open_files_(0) {}
+
+    /* Number of the file named name, adding it to the table if no request has named it before. */
+    int Intern(const std::string& name);
+    /* Name of file; "--" for kNoFile. */
+    const std::string& Name(int file) const;
+
+    /* A request for file enters a device queue. */
+    void Open(int file);
+    /* A request for file leaves its device queue, served or cancelled. */
+    void Close(int file);
+    /* A process requests bytes of I/O on file, 'r' read or 'w' write. */
+    void CountIO(int file, char read_write, int bytes);
+
+    size_t Size() const { return files_.size(); }
+    /* Files with requests waiting at devices. */
+    size_t OpenFiles() const { return open_files_; }
+
+    /* Prints every file with its open requests, requests and bytes read and written. */
+    void Display(std::ostream& out) const;
+
+private:
+    struct FileInfo {
+        std::string name;
+        int open_requests; //requests waiting at devices
+        unsigned long reads;
+        unsigned long writes;
+        unsigned long bytes_read;
+        unsigned long bytes_written;
+    };
+
+    std::unordered_map<std::string, int> numbers_; //Key is the file name.
+    std::vector<FileInfo> files_; //files_[number]
+    size_t open_files_;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "Instrumentation.h"
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/********************Utility Functions********************/
+namespace InstrumentationNamespace {
+
+const char* kProbeNames[Instrumentation::kNumProbes] = {
+    "FillCPU", "AddProcessToReadyQueue", "ProcessSyscall", "DeviceInterrupt", "LoadProcesses", "AssignMemory", "FreeMemory"
+};
+
+struct ProbeTable {
+    unsigned long long calls[Instrumentation::kNumProbes];
+    unsigned long long cycles[Instrumentation::kNumProbes];
+    ProbeTable();
+    ~ProbeTable();
+};
+
+//Every live thread's table, plus the totals of threads that have exited. Only touched when a thread starts, ends or reports.
+std::mutex& TablesLock() { static std::mutex lock; return lock; }
+std::vector<ProbeTable*>& LiveTables() { static std::vector<ProbeTable*> tables; return tables; }
+ProbeTable& RetiredTotals() { static ProbeTable totals; return totals; }
+
+ProbeTable::ProbeTable() {
+    for (int i = 0; i < Instrumentation::kNumProbes; ++i) {
+        calls[i] = 0;
+        cycles[i] = 0;
+    }
+}
+
+ProbeTable::~ProbeTable() {
+    if (this == &RetiredTotals()) return;
+    std::lock_guard<std::mutex> guard(TablesLock());
+    ProbeTable& totals = RetiredTotals();
+    for (int i = 0; i < Instrumentation::kNumProbes; ++i) {
+        totals.calls[i] += calls[i];
+        totals.cycles[i] += cycles[i];
+    }
+    std::vector<ProbeTable*>& tables = LiveTables();
+    for (size_t i = 0; i < tables.size(); ++i)
+        if (tables[i] == this) {
+            tables.erase(tables.begin() + i);
+            break;
+        }
+}
+
+//Table for the calling thread. Registered on first use so the hot path never takes the lock.
+ProbeTable& ThisThreadTable() {
+    thread_local ProbeTable* table = nullptr;
+    thread_local ProbeTable storage;
+    if (table == nullptr) {
+        std::lock_guard<std::mutex> guard(TablesLock());
+        LiveTables().push_back(&storage);
+        table = &storage;
+    }
+    return *table;
+}
+
+} //end InstrumentationNamespace
+
+/********************Public Functions********************/
+namespace Instrumentation {
+
+bool Enabled() {
+#ifdef SIM_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned long long ReadCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void Record(Probe the_probe, unsigned long long the_cycles) {
+    InstrumentationNamespace::ProbeTable& table = InstrumentationNamespace::ThisThreadTable();
+    ++table.calls[the_probe];
+    table.cycles[the_probe] += the_cycles;
+}
+
+void Report(std::ostream& out) {
+    using namespace InstrumentationNamespace;
+    if (!Enabled()) {
+        out << "     Instrumentation is not compiled in. Rebuild with \"make clean; make INSTRUMENT=1\".\n";
+        return;
+    }
+    ProbeTable sum;
+    {
+        std::lock_guard<std::mutex> guard(TablesLock());
+        std::vector<const ProbeTable*> tables(LiveTables().begin(), LiveTables().end());
+        tables.push_back(&RetiredTotals());
+        for (size_t t = 0; t < tables.size(); ++t)
+            for (int i = 0; i < kNumProbes; ++i) {
+                sum.calls[i] += tables[t]->calls[i];
+                sum.cycles[i] += tables[t]->cycles[i];
+            }
+    }
+    unsigned long long total_cycles = 0;
+    for (int i = 0; i < kNumProbes; ++i) total_cycles += sum.cycles[i];
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::dec << "   Hot-path counters (inclusive cycles):\n"
+        << std::left << std::setw(26) << "   Probe" << std::right << std::setw(12) << "Calls|" << std::setw(16) << "Cycles|"
+        << std::setw(14) << "Cycles/Call|" << std::setw(8) << "Share" << std::endl;
+    for (int i = 0; i < kNumProbes; ++i) {
+        double per_call = sum.calls[i] ? double(sum.cycles[i]) / sum.calls[i] : 0.0;
+        double share = total_cycles ? 100.0 * sum.cycles[i] / total_cycles : 0.0;
+        out << "   " << std::left << std::setw(23) << kProbeNames[i] << std::right << std::setw(12) << sum.calls[i]
+            << std::setw(16) << sum.cycles[i] << std::setw(14) << std::fixed << std::setprecision(1) << per_call
+            << std::setw(7) << share << "%" << std::endl;
+    }
+    out.flags(flags);
+}
+
+void Reset() {
+    using namespace InstrumentationNamespace;
+    std::lock_guard<std::mutex> guard(TablesLock());
+    std::vector<ProbeTable*> tables(LiveTables());
+    tables.push_back(&RetiredTotals());
+    for (size_t t = 0; t < tables.size(); ++t)
+        for (int i = 0; i < kNumProbes; ++i) {
+            tables[t]->calls[i] = 0;
+            tables[t]->cycles[i] = 0;
+        }
+}
+
+} //end Instrumentation
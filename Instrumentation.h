@@ -0,0 +1,61 @@
+/*
+ * Author: Emma Kimlin
+ * Title: Instrumentation.h
+ * Date Created: 10.18.2026
+ * Description: Hot-path instrumentation for Scheduler and Memory. Each probe counts calls and the cycles spent inside it
+ *              (rdtsc on x86, steady_clock nanoseconds elsewhere). Counts are kept per thread and summed when reported.
+ *              Probes compile to nothing unless the build defines SIM_INSTRUMENT ("make INSTRUMENT=1").
+ *              Times are inclusive: a probe that calls another probed function also counts the callee's cycles.
+*/
+
+#ifndef Instrumentation_h
+#define Instrumentation_h
+
+#include <iostream>
+
+namespace Instrumentation {
+
+enum Probe {
+    kFillCPU,
+    kAddProcessToReadyQueue,
+    kProcessSyscall,
+    kDeviceInterrupt,
+    kLoadProcesses,
+    kAssignMemory,
+    kFreeMemory,
+    kNumProbes
+};
+
+/* True when the build was made with SIM_INSTRUMENT. */
+bool Enabled();
+
+/* Current value of the cycle counter used by the probes. */
+unsigned long long ReadCycles();
+
+/* Adds one call taking the_cycles to the_probe in this thread's table. */
+void Record(Probe the_probe, unsigned long long the_cycles);
+
+/* Prints calls, cycles and share of total cycles for every probe, summed over all threads. */
+void Report(std::ostream& out);
+
+/* Zeroes every counter in every thread. */
+void Reset();
+
+class ScopedProbe {
+public:
+    explicit ScopedProbe(Probe the_probe) : probe_(the_probe), start_(ReadCycles()) {}
+    ~ScopedProbe() { Record(probe_, ReadCycles() - start_); }
+private:
+    Probe probe_;
+    unsigned long long start_;
+};
+
+} //end Instrumentation
+
+#ifdef SIM_INSTRUMENT
+#define INSTRUMENT_PROBE(the_probe) Instrumentation::ScopedProbe instrument_probe_(Instrumentation::the_probe)
+#else
+#define INSTRUMENT_PROBE(the_probe)
+#endif
+
+#endif
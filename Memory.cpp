@@ -1,4 +1,6 @@
 #include "Memory.h"
+#include "Instrumentation.h"
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
@@ -8,71 +10,263 @@
 namespace MemoryNamespace {
 
 //Utility Function that returns positive integer provided by user.
-int GetPositiveIntFromUser()
+int GetPositiveIntFromUser(std::istream& in, std::ostream& out)
 {
     std::string user_input;
     int integer_value;
     std::stringstream ss;
     bool bad_input = true;
     while (bad_input) {
-        std::cin >> user_input;
+        in >> user_input;
         ss << user_input;
         if ( (ss >> integer_value) && !(ss >> user_input) && (integer_value >= 0) ) //user entered a positive integer that is not trailed by a string
             bad_input = false;
         else {
-            std::cout << "       Invalid Input. Enter a number.";
+            out << "       Invalid Input. Enter a number.";
             ss.str("");
             ss.clear();
         }
     }
     return integer_value;
 }
+
+//Utility Function that returns true if user answers 'y' and false if user answers 'n'.
+bool GetYesNoFromUser(std::istream& in, std::ostream& out)
+{
+    std::string user_input;
+    in >> user_input;
+    while ( (user_input != "y") && (user_input != "n") ) {
+        out << "       Invalid Input. Enter 'y' or 'n'.";
+        in >> user_input;
+    }
+    return user_input == "y";
+}
 } //end MemoryNamespace
 
 /********************Public Member Functions********************/
 
-Memory::Memory() {
-    std::cout << "   Enter the total size of memory. "; 
-    total_memory_size_ = MemoryNamespace::GetPositiveIntFromUser();
+Memory::Memory(std::istream& in, std::ostream& out) : in_(in), out_(out) {
+    out_ << "   Enter the total size of memory. "; 
+    total_memory_size_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
     InitMaxProcessSize();
     InitPageSize();
     num_pages_ = total_memory_size_ / page_size_; 
     max_pages_per_process_ = max_size_process_ / page_size_;
-    for (size_t i = 0; i < num_pages_; ++i) {
-    	free_frame_list_.push_back(i); 
+    reserved_frames_ = 0;
+    for (size_t i = 0; i < num_pages_; ++i)
     	frame_list_.push_back( std::make_pair(-1, -1) );
-    }
+    frame_ref_count_.assign(num_pages_, 0);
+    frame_code_.assign( num_pages_, std::make_pair(-1, -1) );
+    frame_referenced_.assign(num_pages_, false);
+    clock_hand_ = 0;
+    total_references_ = 0;
+    total_faults_ = 0;
+    evictions_ = 0;
+    throttled_admissions_ = 0;
+    admissions_ = 0;
+    suspensions_ = 0;
+    resumptions_ = 0;
+    swap_outs_ = 0;
+    swap_ins_ = 0;
+    pages_swapped_out_ = 0;
+    pages_swapped_in_ = 0;
+    swap_time_ = 0.0;
+    backing_store_pages_ = 0;
+    peak_backing_store_pages_ = 0;
+    recent_fault_rate_ = 0.0;
+    forks_ = 0;
+    shared_code_maps_ = 0;
+    copy_on_write_faults_ = 0;
+    pages_copied_ = 0;
+    writes_refused_ = 0;
+    large_translations_ = 0;
+    large_faults_ = 0;
+    promotions_ = 0;
+    demotions_ = 0;
+    next_interleave_node_ = 0;
+    local_references_ = 0;
+    remote_references_ = 0;
+    remote_allocations_ = 0;
+    node_moves_ = 0;
+    groups_ = nullptr;
+    InitPaging();
+    free_frame_lists_.resize(num_nodes_);
+    for (size_t i = 0; i < num_pages_; ++i)
+        free_frame_lists_[NodeOfFrame(i)].push_back(i);
+    free_frames_ = num_pages_;
+    page_table_.reset( PageTable::Create(page_table_kind_, PagesForProcess(max_size_process_), num_pages_) );
 }
 
 void Memory::InitMaxProcessSize() {
-	std::cout << "   Enter the maximum size of a process for this system. ";
-	max_size_process_ = MemoryNamespace::GetPositiveIntFromUser();
+	out_ << "   Enter the maximum size of a process for this system. ";
+	max_size_process_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
     while (max_size_process_ > total_memory_size_) {
-        std::cout << "       Invalid Entry. Maximum Process Size cannot be greater than total memory.\n" 
-                  << "       Try again.";
-        max_size_process_ = MemoryNamespace::GetPositiveIntFromUser();
+        out_ << "       Invalid Entry. Maximum Process Size cannot be greater than total memory.\n" 
+             << "       Try again.";
+        max_size_process_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
     }
 }
 
 void Memory::InitPageSize() {
-    std::cout << "   Enter the size of a page for this system. ";
-    page_size_ = MemoryNamespace::GetPositiveIntFromUser();
+    out_ << "   Enter the size of a page for this system. ";
+    page_size_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
     while ( ((page_size_ & (page_size_ - 1)) != 0 ) || (page_size_ == 0) || (total_memory_size_ % page_size_) ) {
-        std::cout << "       Invalid Entry. Please enter page size that is a power of two,\n"
-                  << "       greater than zero, and that divides " << total_memory_size_ << " evenly.";
-        page_size_ = MemoryNamespace::GetPositiveIntFromUser();
+        out_ << "       Invalid Entry. Please enter page size that is a power of two,\n"
+             << "       greater than zero, and that divides " << total_memory_size_ << " evenly.";
+        page_size_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
     }
 }
 
-void Memory::FreeMemory(int the_PID) {
-    std::cout << "   Freeing memory that P" << the_PID << " was using. \n";
-    //find the frames a_pcb has used by iteratng through entire frame_list until end. 
-    for (size_t i = 0; i < frame_list_.size(); ++i) {
-        if ( frame_list_[i].first == the_PID ) { //a_pcb was assigned this frame. 
-            frame_list_[i] = std::make_pair(-1, -1); //default value signifies that frame is unused. 
-            free_frame_list_.push_back(i); //Add newly freed frames to free_frame_list_. 
+void Memory::InitPaging() {
+    demand_paging_ = false;
+    working_set_window_ = 100;
+    reference_pattern_ = 'n';
+    references_per_ms_ = 0;
+    write_percent_ = 0;
+    throttle_when_thrashing_ = true;
+    load_policy_ = 'w';
+    pff_lower_ = 0.0;
+    pff_upper_ = 1.0;
+    suspend_when_overloaded_ = false;
+    swapping_ = false;
+    swap_victim_policy_ = 'b';
+    swap_latency_ = 0;
+    swap_time_per_page_ = 0;
+    share_code_ = false;
+    code_percent_ = 0;
+    page_table_kind_ = 'f';
+    large_page_pages_ = 0;
+    num_nodes_ = 1;
+    numa_policy_ = 'f';
+    local_access_ns_ = 100;
+    remote_access_ns_ = 100;
+    out_ << "   Configure advanced memory options? (y/n) ";
+    if ( !MemoryNamespace::GetYesNoFromUser(in_, out_) ) return;
+    out_ << "     Use demand paging? (y/n) ";
+    demand_paging_ = MemoryNamespace::GetYesNoFromUser(in_, out_);
+    out_ << "     Enter the working-set window (number of references). ";
+    working_set_window_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    while (working_set_window_ == 0) {
+        out_ << "       Invalid Entry. The window must be at least one reference.";
+        working_set_window_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    std::string user_input;
+    out_ << "     Enter the memory reference pattern of new processes: 's' sequential, 't' strided,\n"
+         << "     'z' Zipf hot set, 'f' phase-changing working sets, 'm' mixed or 'n' none. ";
+    in_ >> user_input;
+    while ( (user_input.size() != 1) || (std::string("stzfmn").find(user_input[0]) == std::string::npos) ) {
+        out_ << "       Invalid Entry. Enter 's', 't', 'z', 'f', 'm' or 'n'. ";
+        in_ >> user_input;
+    }
+    reference_pattern_ = user_input[0];
+    if (reference_pattern_ != 'n') {
+        out_ << "     Enter the number of memory references per millisecond of CPU time. ";
+        references_per_ms_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+        out_ << "     Enter the percent of memory references that are writes. ";
+        write_percent_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+        while (write_percent_ > 100) {
+            out_ << "       Invalid Entry. Enter a percent from 0 to 100.";
+            write_percent_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
         }
     }
+    if (demand_paging_) { //Pre-paging admits only what fits in free frames; there is no load to control.
+        out_ << "     Enter the load control policy: 'w' working set or 'p' page-fault frequency. ";
+        in_ >> user_input;
+        while ( (user_input != "w") && (user_input != "p") ) {
+            out_ << "       Invalid Entry. Enter 'w' or 'p'. ";
+            in_ >> user_input;
+        }
+        load_policy_ = user_input[0];
+        if (load_policy_ == 'w') {
+            out_ << "     Throttle Job Pool admission while memory is thrashing? (y/n) ";
+            throttle_when_thrashing_ = MemoryNamespace::GetYesNoFromUser(in_, out_);
+        } else {
+            out_ << "     Enter the lower page-fault rate threshold (faults per 1000 references). ";
+            pff_lower_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_) / 1000.0;
+            out_ << "     Enter the upper page-fault rate threshold (faults per 1000 references). ";
+            pff_upper_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_) / 1000.0;
+            while (pff_upper_ < pff_lower_) {
+                out_ << "       Invalid Entry. The upper threshold cannot be below the lower threshold.";
+                pff_upper_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_) / 1000.0;
+            }
+        }
+        out_ << "     Suspend resident processes when memory is overloaded? (y/n) ";
+        suspend_when_overloaded_ = MemoryNamespace::GetYesNoFromUser(in_, out_);
+    }
+    out_ << "     Swap out blocked processes when processes are waiting for memory? (y/n) ";
+    swapping_ = MemoryNamespace::GetYesNoFromUser(in_, out_);
+    if (swapping_ || suspend_when_overloaded_) {
+        if (swapping_) {
+            out_ << "     Enter the swap victim policy: 'b' longest wait in a device queue or 'l' most memory. ";
+            in_ >> user_input;
+            while ( (user_input != "b") && (user_input != "l") ) {
+                out_ << "       Invalid Entry. Enter 'b' or 'l'. ";
+                in_ >> user_input;
+            }
+            swap_victim_policy_ = user_input[0];
+        }
+        out_ << "     Enter the backing store latency per swap (ms). ";
+        swap_latency_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+        out_ << "     Enter the backing store transfer time per page (ms). ";
+        swap_time_per_page_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    out_ << "     Share code pages between instances of the same program? (y/n) ";
+    share_code_ = MemoryNamespace::GetYesNoFromUser(in_, out_);
+    if (share_code_) {
+        out_ << "     Enter the percent of a program's pages that are code. ";
+        code_percent_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+        while (code_percent_ > 100) {
+            out_ << "       Invalid Entry. Enter a percent from 0 to 100.";
+            code_percent_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+    }
+    out_ << "     Enter the page table: 'f' flat, '2' two-level, '3' three-level or 'h' hashed inverted. ";
+    in_ >> user_input;
+    while ( (user_input != "f") && (user_input != "2") && (user_input != "3") && (user_input != "h") ) {
+        out_ << "       Invalid Entry. Enter 'f', '2', '3' or 'h'. ";
+        in_ >> user_input;
+    }
+    page_table_kind_ = user_input[0];
+    out_ << "     Enter the large page size in base pages (a power of two, or 0 for base pages only). ";
+    large_page_pages_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    while ( (large_page_pages_ == 1) || ((large_page_pages_ & (large_page_pages_ - 1)) != 0) || (large_page_pages_ > num_pages_) ) {
+        out_ << "       Invalid Entry. Enter 0, or a power of two from 2 to " << num_pages_ << ".";
+        large_page_pages_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    out_ << "     Enter the number of NUMA nodes (1 for uniform memory access). ";
+    num_nodes_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    while ( (num_nodes_ == 0) || (num_nodes_ > num_pages_) ) {
+        out_ << "       Invalid Entry. Enter a number from 1 to " << num_pages_ << ".";
+        num_nodes_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    if (num_nodes_ == 1) return;
+    out_ << "     Enter the NUMA allocation policy: 'f' first touch or 'i' interleave. ";
+    in_ >> user_input;
+    while ( (user_input != "f") && (user_input != "i") ) {
+        out_ << "       Invalid Entry. Enter 'f' or 'i'. ";
+        in_ >> user_input;
+    }
+    numa_policy_ = user_input[0];
+    out_ << "     Enter the local memory access time (ns). ";
+    local_access_ns_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+    out_ << "     Enter the remote memory access time (ns). ";
+    remote_access_ns_ = MemoryNamespace::GetPositiveIntFromUser(in_, out_);
+}
+
+void Memory::FreeMemory(int the_PID) {
+    INSTRUMENT_PROBE(kFreeMemory);
+    out_ << "   Freeing memory that P" << the_PID << " was using. \n";
+    auto info = processes_.find(the_PID);
+    if (info == processes_.end()) return;
+    ProcessMemoryInfo& process = info->second;
+    DemoteAll(the_PID, process);
+    std::vector< std::pair<int, int> > pages;
+    page_table_->MappedPages(the_PID, pages);
+    for (size_t i = 0; i < pages.size(); ++i) //Frames no other process shares are freed.
+        UnmapPage(the_PID, process, pages[i].first);
+    page_table_->RemoveProcess(the_PID);
+    if (process.swapped_out) backing_store_pages_ -= process.swapped_pages.size(); //Its backing store pages are discarded.
+    processes_.erase(info);
 }
 
 void Memory::KillProcessInJobPool(int the_PID) {
@@ -80,7 +274,7 @@ void Memory::KillProcessInJobPool(int the_PID) {
     while ( iter != job_pool_.end() ) {
         if (iter->getPID() == the_PID) {
             job_pool_.erase(iter); 
-            std::cout << "     P" << the_PID << " (located in Job Pool) has been killed.\n";
+            out_ << "     P" << the_PID << " (located in Job Pool) has been killed.\n";
             return;
         }
         ++iter;
@@ -88,102 +282,115 @@ void Memory::KillProcessInJobPool(int the_PID) {
 }
 
 bool Memory::AssignMemory(const PCB& a_pcb) {
-	size_t num_pages_needed = ceil( a_pcb.getSizeOfProcess() / page_size_) ; // Check to see if there are enough frames available for this process.
-    int the_PID = a_pcb.getPID();
-	if (free_frame_list_.size() < num_pages_needed) { //Not enough frames available--put into Job Pool until there are. 
+    INSTRUMENT_PROBE(kAssignMemory);
+	if ( !FitsInMemory(a_pcb) ) { //Not enough frames available--put into Job Pool until there are. 
 		job_pool_.insert(a_pcb); 
-        std::cout << "     There is not enough memory for this Job. Inserted into Job Pool.\n";
+        if ( !FitsInGroup(a_pcb) ) {
+            groups_->CountHeldJob( a_pcb.getGroup() );
+            out_ << "     Group " << a_pcb.getGroup() << " has no room for this Job under its frame limit. Inserted into Job Pool.\n";
+        } else if (demand_paging_ && Overloaded()) {
+            ++throttled_admissions_;
+            out_ << "     Memory is overloaded. Job inserted into Job Pool.\n";
+        } else 
+            out_ << "     There is not enough memory for this Job. Inserted into Job Pool.\n";
 		return false;
 	}
-	for (size_t i = 0; i < num_pages_needed; ++i) { //Enough free frames--Assign a free frame to every page the process requires.
-		int frame = free_frame_list_.front(); 
-		free_frame_list_.pop_front(); 
-		frame_list_[frame] = std::pair<int, int>(the_PID, i); 
-	}
+    LoadPages(a_pcb);
     return true;
 }
 
-PCB Memory::AssignMemoryToProcessInJobPool() {  //assign to frames, take out of free frame list, and take out of job pool
+bool Memory::AssignMemoryToProcessInJobPool(PCB& ready_pcb) {  //assign to frames, take out of free frame list, and take out of job pool
     auto iter = job_pool_.begin(); //start with largest job in job_pool_
     while ( iter != job_pool_.end() ) {
-        size_t num_pages_needed = ceil( iter->getSizeOfProcess() / page_size_);
-        if ( num_pages_needed <= free_frame_list_.size() ) { //Found biggest job in Job Pool that can be assigned frames.
-            std::cout <<"   Assigning P" << iter->getPID() << " (from Job Pool) memory. \n";
-            for (size_t i = 0; i < num_pages_needed; ++i) { //Assign a free frame to every page the process requires.
-                int frame = free_frame_list_.front(); 
-                free_frame_list_.pop_front(); //Remove frames from free_frame_list_ now that they are assigned. 
-                frame_list_[frame] = std::make_pair(iter->getPID(), i); //Assign frames
-            }
-            PCB a_ready_pcb = *iter; //take the job that was just assigned memory out of the job pool 
+        if ( FitsInMemory(*iter) ) { //Found biggest job in Job Pool that can be assigned frames.
+            out_ <<"   Assigning P" << iter->getPID() << " (from Job Pool) memory. \n";
+            LoadPages(*iter);
+            ready_pcb = *iter; //take the job that was just assigned memory out of the job pool 
             job_pool_.erase(iter); //delete this job out of Job Pool now that it is assigned.
-            return a_ready_pcb;
+            return true;
         }   
         ++iter; 
     }
-    std::cout << "Error. Cannot assign memory to jobs in Job Pool if no memory available. \n";
-    exit(1);
+    return false; //No memory available for any job in the Job Pool.
 }
 
 void Memory::DisplayFreeFrameList() const {
-	std::cout << "   Free Frames: ";
-    if ( free_frame_list_.empty() ) {
-        std::cout << "   Empty.\n";
+	out_ << "   Free Frames: ";
+    if (free_frames_ == 0) {
+        out_ << "   Empty.\n";
         return;
     }
-	auto iter = free_frame_list_.begin(); 
-	while (iter != free_frame_list_.end()) {
-		std::cout << *iter << " "; 
-		++iter; 
-	}
-	std::cout << std::endl;
+    for (size_t node = 0; node < num_nodes_; ++node) {
+        if (num_nodes_ > 1) out_ << "[node " << node << "] ";
+        auto iter = free_frame_lists_[node].begin(); 
+        while (iter != free_frame_lists_[node].end()) {
+            out_ << *iter << " "; 
+            ++iter; 
+        }
+    }
+	out_ << std::endl;
 }
 
 void Memory::DisplayFrameList() const {
-    std::cout << "PID" << std::setw(14) << "Page Number" << std::endl;
-    for (auto iter = frame_list_.begin(); iter != frame_list_.end(); ++iter) {
-        if (iter->first != -1)
-            std::cout << iter->first << std::setw(14) << iter->second << std::endl;
-        else 
-            std::cout << "Unused" << std::endl;
+    out_ << "PID" << std::setw(14) << "Page Number" << std::endl;
+    for (size_t i = 0; i < frame_list_.size(); ++i) {
+        if (frame_list_[i].first == -1)
+            out_ << "Unused" << std::endl;
+        else if (frame_ref_count_[i] > 1)
+            out_ << frame_list_[i].first << std::setw(14) << frame_list_[i].second << "  shared by " << std::dec
+                 << frame_ref_count_[i] << std::endl;
+        else
+            out_ << frame_list_[i].first << std::setw(14) << frame_list_[i].second << std::endl;
     }
 }
 
 void Memory::DisplayJobPool() const {
-    std::cout << "   Job Pool: " << std::endl;
+    out_ << "   Job Pool: " << std::endl;
     if ( job_pool_.empty() ) {
-        std::cout << "   Empty" << std::endl;
+        out_ << "   Empty" << std::endl;
         return;
     }
     auto iter = job_pool_.begin(); 
     while ( iter != job_pool_.end() ) {
-        std::cout << iter->getPID() << std::setw(7) << iter->getSizeOfProcess() << std::endl;
+        out_ << iter->getPID() << std::setw(7) << iter->getSizeOfProcess() << std::endl;
         ++iter;
     }
 }
 void Memory::DisplayPageTable(int PID) const {
-    std::cout << "P" << PID << ": ";
-    //Search frametable:
-    for (size_t i = 0; i < frame_list_.size(); ++i) { //go through Frame Table until you have displayed all of the frames this process uses 
-        if (frame_list_[i].first == PID) 
-            std::cout << i << " ";
+    out_ << "P" << PID << ": ";
+    auto info = processes_.find(PID);
+    if (info != processes_.end()) {
+        const ProcessMemoryInfo& process = info->second;
+        for (size_t i = 0; i < process.num_pages; ++i) { //Frame of every page in memory; '*' marks copy-on-write, 'L' large.
+            int frame = LookupFrame(PID, process, i, false);
+            if (frame == -1) continue;
+            bool large = (large_page_pages_ > 0) && (i / large_page_pages_ < process.large_pages.size())
+                         && (process.large_pages[i / large_page_pages_] != -1);
+            out_ << std::dec << frame << (process.copy_on_write[i] ? "* " : (large ? "L " : " "));
+        }
     }
-    std::cout << std::endl;
+    out_ << std::endl;
 }
 
 bool Memory::MemoryForWaitingProcesses() const {
     if ( job_pool_.empty() ) {
-        std::cout << "     The Job Pool is empty. No Processes to assign memory. \n";
+        out_ << "     The Job Pool is empty. No Processes to assign memory. \n";
         return false;
     }
     auto iter = job_pool_.begin(); //start with largest job in job_pool_
     while ( iter != job_pool_.end() ) {
-        size_t num_pages_needed = ceil( iter->getSizeOfProcess() / page_size_);
-        if ( num_pages_needed <= free_frame_list_.size() ) return true;
+        if ( FitsInMemory(*iter) ) return true;
         ++iter; 
     }
     return false;
 } 
 
+bool Memory::ExceedsGroupLimit(const PCB& a_pcb) const {
+    if (groups_ == nullptr) return false;
+    size_t limit = groups_->FrameLimit( a_pcb.getGroup() );
+    return (limit > 0) && (AdmissionFrames(a_pcb) > limit);
+}
+
 bool Memory::ProcessInJobPool(int the_PID) const {
     auto iter = job_pool_.begin();
     while ( iter != job_pool_.end() ) {
@@ -198,7 +405,9 @@ int Memory::CalculatePhysicalAddress(const int& logical_address, const int& PID)
     std::div_t divresult = std::div(logical_address, page_size_);
     int offset = divresult.rem; 
     int page_number = divresult.quot; 
-    int frame_number = GetFrameNumber(page_number, PID);
+    if ( IsSwappedOut(PID) ) return -1;
+    int frame_number = FindFrame(page_number, PID);
+    if (frame_number == -1) return -1; //Page is not in memory.
     std::string frame_num_str = std::to_string(frame_number);
     std::string offset_str = std::to_string(offset);
     std::string physical_address_str = frame_num_str + offset_str;
@@ -211,39 +420,768 @@ int Memory::CalculatePhysicalAddress(const int& logical_address, const int& PID)
 
 void Memory::DisplayPhysicalAddress(int logical_address, int PID) const {
     if (logical_address == 0) {
-        std::cout << "     Physical Address is 0." << std::endl;
+        out_ << "     Physical Address is 0." << std::endl;
         return;
     }
     int p_add = CalculatePhysicalAddress(logical_address, PID);
-    std::cout << "     Physical Address is " << std::hex << p_add << std::endl;
+    if (p_add == -1)
+        out_ << "     Page is not in memory. No Physical Address." << std::endl;
+    else
+        out_ << "     Physical Address is " << std::hex << p_add << std::endl;
 } 
 
 int Memory::GetFrameNumber(const int& page_number, const int& PID) const {
-    for (size_t i = 0; i < frame_list_.size(); ++i) {
-        if ( (frame_list_[i].first == PID) && (frame_list_[i].second == page_number) ) 
-            return i; 
+    return FindFrame(page_number, PID);
+}
+
+int Memory::ReferencePage(int the_PID, int page_number, bool write) {
+    auto info = processes_.find(the_PID);
+    if (info == processes_.end()) return -1; //Process is not in memory.
+    ProcessMemoryInfo& process = info->second;
+    if ( (page_number < 0) || ((size_t)page_number >= process.num_pages) ) return -1;
+    ++total_references_;
+    ++process.references;
+    UpdateWorkingSet(process.working_set, page_number);
+    int frame = LookupFrame(the_PID, process, page_number, true);
+    double fault = (frame == -1) ? 1.0 : 0.0;
+    double alpha = 1.0 / working_set_window_;
+    recent_fault_rate_ += alpha * (fault - recent_fault_rate_);
+    process.fault_rate += alpha * (fault - process.fault_rate);
+    if (frame == -1) {
+        ++total_faults_;
+        ++process.faults;
+        frame = BringInPage(the_PID, process, page_number);
+    }
+    if ( write && process.copy_on_write[page_number] ) frame = CopyOnWrite(the_PID, process, page_number);
+    frame_referenced_[frame] = true;
+    if (NodeOfFrame(frame) == process.node) ++local_references_;
+    else {
+        ++remote_references_;
+        ++process.remote_references;
     }
-    std::cout << "       Error: Process " << PID << " not allocated memory. Enter another command.\n";
-    exit(1);
+    return frame;
 }
 
+int Memory::ProgramID(const std::string& the_name) {
+    auto iter = program_ids_.find(the_name);
+    if (iter != program_ids_.end()) return iter->second;
+    SharedProgram program;
+    program.name = the_name;
+    program.code_pages = 0;
+    program.sized = false;
+    programs_.push_back(program);
+    program_ids_[the_name] = programs_.size() - 1;
+    return programs_.size() - 1;
+}
 
+bool Memory::ForkProcess(int the_parent_PID, const PCB& the_child) {
+    auto parent = processes_.find(the_parent_PID);
+    if ( (parent == processes_.end()) || parent->second.swapped_out ) return false;
+    if (!demand_paging_) { //Every page is copied now, so later copies never need to replace a page.
+        std::vector< std::pair<int, int> > pages;
+        page_table_->MappedPages(the_parent_PID, pages);
+        size_t to_copy = 0;
+        for (size_t i = 0; i < pages.size(); ++i)
+            if (SharedCodeFrame(parent->second, pages[i].first) != pages[i].second) ++to_copy;
+        for (size_t run = 0; run < parent->second.large_pages.size(); ++run)
+            if (parent->second.large_pages[run] != -1) to_copy += large_page_pages_;
+        if (to_copy > free_frames_) return false;
+    }
+    ProcessMemoryInfo child = NewProcessInfo(the_child);
+    child.num_pages = parent->second.num_pages;
+    child.program = parent->second.program;
+    child.node = parent->second.node; //Runs where its parent ran, next to the frames it shares.
+    child.copy_on_write.assign(child.num_pages, false);
+    child.working_set.counts.assign(child.num_pages, 0);
+    ProcessMemoryInfo& process = processes_[the_child.getPID()] = child;
+    page_table_->AddProcess(the_child.getPID(), child.num_pages);
+    DemoteAll(the_parent_PID, parent->second); //Copy-on-write is tracked per base page.
+    std::vector< std::pair<int, int> > pages;
+    page_table_->MappedPages(the_parent_PID, pages);
+    size_t copied = 0;
+    for (size_t i = 0; i < pages.size(); ++i) { //Pages not in memory are not copied: the child faults in its own.
+        if ( !demand_paging_ && (SharedCodeFrame(process, pages[i].first) != pages[i].second) ) {
+            MapPage(the_child.getPID(), process, pages[i].first, AllocateFrame(process.node, process.group), false);
+            ++pages_copied_;
+            ++copied;
+            continue;
+        }
+        MapPage(the_child.getPID(), process, pages[i].first, pages[i].second, true);
+        parent->second.copy_on_write[pages[i].first] = true;
+    }
+    ++admissions_;
+    ++forks_;
+    if (copied == 0)
+        out_ << "     P" << the_child.getPID() << " shares " << std::dec << process.resident << " frames of P"
+             << the_parent_PID << " copy-on-write.\n";
+    else
+        out_ << "     P" << the_child.getPID() << " copies " << std::dec << copied << " pages of P" << the_parent_PID
+             << " and shares " << process.resident - copied << " code frames.\n";
+    return true;
+}
+
+void Memory::DisplaySharing() const {
+    size_t shared_frames = 0, frames_saved = 0;
+    for (size_t i = 0; i < frame_ref_count_.size(); ++i)
+        if (frame_ref_count_[i] > 1) {
+            ++shared_frames;
+            frames_saved += frame_ref_count_[i] - 1;
+        }
+    out_ << "   Code sharing: " << (share_code_ ? "on" : "off");
+    if (share_code_) out_ << ", " << std::dec << code_percent_ << "% of a program is code, " << programs_.size()
+                          << " programs";
+    out_ << ".\n"
+         << "   Shared frames: " << std::dec << shared_frames << "  Frames saved by sharing: " << frames_saved
+         << "  Forks: " << forks_ << "  Shared code page faults: " << shared_code_maps_ << std::endl
+         << "   Copy-on-write faults: " << copy_on_write_faults_ << "  Pages copied: " << pages_copied_
+         << "  Writes refused: " << writes_refused_ << std::endl;
+}
+
+size_t Memory::WorkingSetDemand() const {
+    size_t demand = 0;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter)
+        if (!iter->second.swapped_out) demand += EstimatedWorkingSet(iter->second);
+    return demand;
+}
+
+bool Memory::Overloaded() const {
+    if (!demand_paging_) return false;
+    if (load_policy_ == 'p') return recent_fault_rate_ > pff_upper_;
+    return throttle_when_thrashing_ && Thrashing();
+}
+
+int Memory::ChooseSuspendVictim(const std::vector<int>& candidates) const {
+    int victim = -1;
+    size_t most_frames = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        auto info = processes_.find(candidates[i]);
+        if ( (info == processes_.end()) || info->second.swapped_out ) continue;
+        size_t frames = PrivateFrames(candidates[i]);
+        if ( (victim == -1) || (frames > most_frames) ) {
+            victim = candidates[i];
+            most_frames = frames;
+        }
+    }
+    return victim;
+}
+
+void Memory::SuspendProcess(int the_PID) {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || info->second.swapped_out ) return;
+    out_ << "   Memory is overloaded. Suspending P" << the_PID << ". \n";
+    SwapOut(the_PID);
+    info->second.suspended = true;
+    ++suspensions_;
+}
 
+bool Memory::CanResume(int the_PID) const {
+    return IsSwappedOut(the_PID) && (FramesShortToSwapIn(the_PID) == 0);
+}
+
+void Memory::ResumeProcess(int the_PID) {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || !info->second.swapped_out ) return;
+    out_ << "   Resuming P" << the_PID << ". \n";
+    if (info->second.suspended) ++resumptions_;
+    info->second.suspended = false;
+    SwapIn(the_PID);
+}
+
+void Memory::SwapOut(int the_PID) {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || info->second.swapped_out ) return;
+    ProcessMemoryInfo& process = info->second;
+    process.swapped_pages.clear();
+    DemoteAll(the_PID, process);
+    std::vector< std::pair<int, int> > pages;
+    page_table_->MappedPages(the_PID, pages);
+    for (size_t i = 0; i < pages.size(); ++i) {
+        process.swapped_pages.push_back(pages[i].first);
+        UnmapPage(the_PID, process, pages[i].first); //A shared frame stays in memory for the processes still mapping it.
+    }
+    double cost = swap_latency_ + double(swap_time_per_page_) * process.swapped_pages.size();
+    out_ << "   Swapping out P" << the_PID << ": " << std::dec << process.swapped_pages.size() 
+         << " pages to the backing store (" << cost << " ms). \n";
+    process.swapped_out = true;
+    ++process.swaps;
+    process.swap_time += cost;
+    ++swap_outs_;
+    pages_swapped_out_ += process.swapped_pages.size();
+    swap_time_ += cost;
+    backing_store_pages_ += process.swapped_pages.size();
+    if (backing_store_pages_ > peak_backing_store_pages_) peak_backing_store_pages_ = backing_store_pages_;
+}
+
+void Memory::SwapIn(int the_PID) {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || !info->second.swapped_out ) return;
+    ProcessMemoryInfo& process = info->second;
+    process.swapped_out = false;
+    for (size_t i = 0; i < process.swapped_pages.size(); ++i) { //Free frames first; demand paging may also replace pages.
+        int page = process.swapped_pages[i];
+        if (LookupFrame(the_PID, process, page, false) != -1) continue; //Came back with a large page.
+        if ( (SharedCodeFrame(process, page) == -1) && (free_frames_ == 0) && !demand_paging_ ) continue;
+        BringInPage(the_PID, process, page);
+    }
+    double cost = swap_latency_ + double(swap_time_per_page_) * process.resident;
+    out_ << "   Swapping in P" << the_PID << ": " << std::dec << process.resident << " pages from the backing store ("
+         << cost << " ms). \n";
+    process.swap_time += cost;
+    ++swap_ins_;
+    pages_swapped_in_ += process.resident;
+    swap_time_ += cost;
+    backing_store_pages_ -= process.swapped_pages.size();
+    process.swapped_pages.clear();
+}
 
+bool Memory::IsSwappedOut(int the_PID) const {
+    auto info = processes_.find(the_PID);
+    return (info != processes_.end()) && info->second.swapped_out;
+}
 
+size_t Memory::SwapOutGain(int the_PID) const {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || info->second.swapped_out ) return 0;
+    return demand_paging_ ? EstimatedWorkingSet(info->second) : PrivateFrames(the_PID);
+}
 
+size_t Memory::FramesShortForJobPool() const {
+    size_t fewest = 0;
+    bool found = false;
+    for (auto iter = job_pool_.begin(); iter != job_pool_.end(); ++iter) {
+        size_t num_pages = PagesForProcess(iter->getSizeOfProcess());
+        size_t estimate = num_pages < working_set_window_ ? num_pages : working_set_window_;
+        if ( !FitsInGroup(*iter) ) continue; //Memory given back by other groups would not admit it.
+        size_t short_by = FramesShort(FramesNeeded(*iter), estimate);
+        if ( !found || (short_by < fewest) ) fewest = short_by;
+        found = true;
+    }
+    return fewest;
+}
 
+size_t Memory::FramesShortToSwapIn(int the_PID) const {
+    auto info = processes_.find(the_PID);
+    if ( (info == processes_.end()) || !info->second.swapped_out ) return 0;
+    return FramesShort(info->second.swapped_pages.size(), EstimatedWorkingSet(info->second));
+}
 
+void Memory::DisplaySwapStats() const {
+    out_ << "   Swapping of blocked processes: " << (swapping_ ? "on" : "off");
+    if (swapping_) out_ << ", victim policy " << (swap_victim_policy_ == 'b' ? "longest wait" : "most memory");
+    out_ << ". Backing store: " << std::dec << swap_latency_ << " ms per swap + " << swap_time_per_page_
+         << " ms per page.\n"
+         << "   Swap outs: " << swap_outs_ << " (" << pages_swapped_out_ << " pages)  Swap ins: " << swap_ins_
+         << " (" << pages_swapped_in_ << " pages)  Swap time: " << swap_time_ << " ms\n"
+         << "   Backing store: " << backing_store_pages_ << " pages now, " << peak_backing_store_pages_ << " at peak\n";
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter)
+        if (iter->second.swaps > 0)
+            out_ << "     P" << iter->first << ": " << iter->second.swaps << " swaps, " << iter->second.swap_time
+                 << " ms" << (iter->second.swapped_out ? ", swapped out" : "") << std::endl;
+}
 
+void Memory::DisplayLoadControl() const {
+    size_t in_memory = 0;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter)
+        if (!iter->second.swapped_out) ++in_memory;
+    out_ << "   Load control: ";
+    if (!demand_paging_) out_ << "pre-paging (admit when every page fits in free frames)";
+    else if (load_policy_ == 'p') out_ << "page-fault frequency, thresholds " << pff_lower_ << " and " << pff_upper_
+                                       << " faults per reference";
+    else out_ << "working set" << (throttle_when_thrashing_ ? ", throttled while thrashing" : "");
+    out_ << (LoadControlEnabled() ? ", suspends when overloaded." : ".") << std::endl
+         << "   Recent fault rate: " << recent_fault_rate_ << "  Working-set demand: " << WorkingSetDemand()
+         << " of " << num_pages_ << " frames" << (Overloaded() ? "  OVERLOADED" : "") << std::endl
+         << "   Multiprogramming level: " << in_memory << "  Swapped out: " << processes_.size() - in_memory
+         << "  Job Pool: " << job_pool_.size() << std::endl
+         << "   Admitted: " << admissions_ << "  Refused by policy: " << throttled_admissions_
+         << "  Suspensions: " << suspensions_ << "  Resumptions: " << resumptions_ << std::endl;
+}
 
+void Memory::DisplayWorkingSets() const {
+    out_ << "   Paging: " << (demand_paging_ ? "demand" : "pre-paging") << ", working-set window " << std::dec
+         << working_set_window_ << " references.\n";
+    out_ << "PID|" << std::setw(7) << "Pages|" << std::setw(10) << "Resident|" << std::setw(6) << "WSS|"
+         << std::setw(12) << "References|" << std::setw(8) << "Faults|" << std::setw(12) << "Fault Rate" << std::endl;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter) {
+        const ProcessMemoryInfo& info = iter->second;
+        out_ << iter->first << std::setw(7) << info.num_pages << std::setw(10) << info.resident << std::setw(6)
+             << EstimatedWorkingSet(info) << std::setw(12) << info.references << std::setw(8) << info.faults
+             << std::setw(12) << info.fault_rate << (info.suspended ? "  suspended" : (info.swapped_out ? "  swapped out" : "")) << std::endl;
+    }
+    out_ << "   Working-set demand: " << WorkingSetDemand() << " of " << num_pages_ << " frames."
+         << (Thrashing() ? " Memory is thrashing." : "") << std::endl
+         << "   References: " << total_references_ << "  Page faults: " << total_faults_ << "  Evictions: "
+         << evictions_ << "  Admissions throttled: " << throttled_admissions_ << std::endl;
+}
 
+void Memory::DisplayTranslation() const {
+    out_ << "   Page table: " << page_table_->Name() << ", " << std::dec << page_table_->OverheadBytes()
+         << " bytes for " << processes_.size() << " processes.\n"
+         << "   Translations: " << page_table_->Translations() << "  Table entries read per translation: "
+         << page_table_->AccessesPerTranslation() << std::endl;
+    if (large_page_pages_ == 0) return;
+    size_t in_use = LargePagesInUse();
+    double accesses = page_table_->AccessesPerTranslation() * page_table_->Translations() + large_translations_;
+    unsigned long translations = page_table_->Translations() + large_translations_;
+    out_ << "   Large pages: " << large_page_pages_ << " base pages (" << large_page_pages_ * page_size_
+         << " bytes). In use: " << in_use << "  Page table entries saved: " << in_use * (large_page_pages_ - 1)
+         << std::endl
+         << "   Translations through large pages: " << large_translations_ << "  Entries read per translation with them: "
+         << (translations ? accesses / translations : 0.0) << std::endl
+         << "   Large page faults: " << large_faults_ << "  Promotions: " << promotions_ << "  Demotions: "
+         << demotions_ << std::endl;
+}
 
+size_t Memory::ReservableFrames() const {
+    size_t largest = PagesForProcess(max_size_process_);
+    return num_pages_ > largest ? num_pages_ - largest : 0;
+}
 
+void Memory::ReserveFrames(size_t num_frames) {
+    if (num_frames > ReservableFrames()) num_frames = ReservableFrames();
+    reserved_frames_ += num_frames;
+    num_pages_ -= num_frames;
+    total_memory_size_ -= num_frames * page_size_;
+    frame_list_.resize(num_pages_);
+    frame_ref_count_.resize(num_pages_);
+    frame_code_.resize(num_pages_);
+    frame_referenced_.resize(num_pages_);
+    if (num_nodes_ > num_pages_) num_nodes_ = num_pages_;
+    free_frame_lists_.assign(num_nodes_, std::deque<size_t>()); //Frames are split between nodes again.
+    for (size_t i = 0; i < num_pages_; ++i)
+        free_frame_lists_[NodeOfFrame(i)].push_back(i);
+    free_frames_ = num_pages_;
+}
 
+int Memory::PlaceProcess(int the_PID) {
+    auto info = processes_.find(the_PID);
+    if (info == processes_.end()) return 0;
+    ProcessMemoryInfo& process = info->second;
+    int best = process.node;
+    for (size_t node = 0; node < num_nodes_; ++node)
+        if (process.node_resident[node] > process.node_resident[best]) best = node;
+    if (best != process.node) ++node_moves_;
+    process.node = best;
+    return best;
+}
 
+void Memory::DisplayNUMA() const {
+    out_ << "   NUMA nodes: " << std::dec << num_nodes_;
+    if (num_nodes_ == 1) {
+        out_ << " (uniform memory access).\n";
+        return;
+    }
+    out_ << ", " << (numa_policy_ == 'f' ? "first touch" : "interleave") << " allocation. Access time: "
+         << local_access_ns_ << " ns local, " << remote_access_ns_ << " ns remote.\n   Free frames per node:";
+    for (size_t node = 0; node < num_nodes_; ++node) out_ << " " << free_frame_lists_[node].size();
+    unsigned long references = local_references_ + remote_references_;
+    double access_ns = double(local_references_) * local_access_ns_ + double(remote_references_) * remote_access_ns_;
+    out_ << std::endl
+         << "   Local references: " << local_references_ << "  Remote references: " << remote_references_
+         << "  Average access time: " << (references ? access_ns / references : 0.0) << " ns" << std::endl
+         << "   Allocations off the process's node: " << remote_allocations_ << "  Processes moved to another node: "
+         << node_moves_ << std::endl;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter) {
+        if (iter->second.references == 0) continue;
+        out_ << "     P" << iter->first << ": node " << iter->second.node << ", frames per node";
+        for (size_t node = 0; node < num_nodes_; ++node) out_ << " " << iter->second.node_resident[node];
+        out_ << ", " << iter->second.remote_references << " of " << iter->second.references
+             << " references remote" << std::endl;
+    }
+}
 
+/********************Private Member Functions********************/
 
+int Memory::FindFrame(int page_number, int PID) const {
+    auto info = processes_.find(PID);
+    if ( (info == processes_.end()) || (page_number < 0) || ((size_t)page_number >= info->second.num_pages) ) return -1;
+    return LookupFrame(PID, info->second, page_number, true);
+}
 
+bool Memory::FitsInMemory(const PCB& a_pcb) const {
+    if ( !FitsInGroup(a_pcb) ) return false;
+    if (!demand_paging_) return FramesNeeded(a_pcb) <= free_frames_;
+    return AdmissionAllowed( AdmissionFrames(a_pcb) );
+}
 
+size_t Memory::AdmissionFrames(const PCB& a_pcb) const {
+    if (!demand_paging_) return FramesNeeded(a_pcb);
+    size_t num_pages_needed = PagesForProcess(a_pcb.getSizeOfProcess());
+    return num_pages_needed < working_set_window_ ? num_pages_needed : working_set_window_;
+}
 
-    
\ No newline at end of file
+bool Memory::FitsInGroup(const PCB& a_pcb) const {
+    if (groups_ == nullptr) return true;
+    size_t needed = AdmissionFrames(a_pcb);
+    for (int group = a_pcb.getGroup(); group != ProcessGroups::kTopLevel; group = groups_->Parent(group)) {
+        size_t limit = groups_->MaxFrames(group);
+        if (limit == 0) continue;
+        size_t in_use = demand_paging_ ? GroupWorkingSetDemand(group) : groups_->Frames(group);
+        if (in_use + needed > limit) return false;
+    }
+    return true;
+}
+
+size_t Memory::GroupWorkingSetDemand(int group) const {
+    size_t demand = 0;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter)
+        if ( !iter->second.swapped_out && groups_->Within(iter->second.group, group) )
+            demand += EstimatedWorkingSet(iter->second);
+    return demand;
+}
+
+int Memory::GroupVictim(int group) {
+    size_t num_frames = frame_list_.size();
+    for (size_t n = 0; n < 2 * num_frames; ++n) { //Clock algorithm over the group's frames: a second pass finds one.
+        size_t frame = (clock_hand_ + n) % num_frames;
+        if (frame_ref_count_[frame] == 0) continue;
+        auto owner = processes_.find(frame_list_[frame].first);
+        if ( (owner == processes_.end()) || !groups_->Within(owner->second.group, group) ) continue;
+        if (frame_referenced_[frame]) {
+            frame_referenced_[frame] = false;
+            continue;
+        }
+        return frame;
+    }
+    return -1;
+}
+
+bool Memory::AdmissionAllowed(size_t working_set) const {
+    if (Overloaded()) return false;
+    if ( (load_policy_ == 'p') && (recent_fault_rate_ <= pff_lower_) ) return true; //Faulting rarely: memory has room.
+    return WorkingSetDemand() + working_set <= num_pages_;
+}
+
+size_t Memory::FramesShort(size_t num_pages, size_t working_set) const {
+    if (!demand_paging_) return num_pages > free_frames_ ? num_pages - free_frames_ : 0;
+    if ( AdmissionAllowed(working_set) ) return 0;
+    size_t demand = WorkingSetDemand() + working_set;
+    return demand > num_pages_ ? demand - num_pages_ : 1; //Refused by fault rate: any swap out may help.
+}
+
+size_t Memory::FramesNeeded(const PCB& a_pcb) const {
+    size_t num_pages = PagesForProcess(a_pcb.getSizeOfProcess());
+    int program = a_pcb.getProgram();
+    if ( !share_code_ || (program < 0) || ((size_t)program >= programs_.size()) ) return num_pages;
+    const std::vector<int>& code_frames = programs_[program].code_frames;
+    size_t shared = 0;
+    for (size_t i = 0; (i < code_frames.size()) && (i < num_pages); ++i)
+        if (code_frames[i] != -1) ++shared;
+    return num_pages - shared;
+}
+
+void Memory::LoadPages(const PCB& a_pcb) {
+    ProcessMemoryInfo& info = processes_[a_pcb.getPID()] = NewProcessInfo(a_pcb);
+    page_table_->AddProcess(a_pcb.getPID(), info.num_pages);
+    ++admissions_;
+    if (demand_paging_) return; //Pages are brought in by page faults.
+	for (size_t i = 0; i < info.num_pages; ++i) //Enough free frames--Assign a frame to every page the process requires.
+		if (LookupFrame(a_pcb.getPID(), info, i, false) == -1) BringInPage(a_pcb.getPID(), info, i);
+}
+
+ProcessMemoryInfo Memory::NewProcessInfo(const PCB& a_pcb) {
+    ProcessMemoryInfo info;
+    info.num_pages = PagesForProcess(a_pcb.getSizeOfProcess());
+    info.resident = 0;
+    info.references = 0;
+    info.faults = 0;
+    info.fault_rate = 0.0;
+    info.swapped_out = false;
+    info.suspended = false;
+    info.swaps = 0;
+    info.swap_time = 0.0;
+    info.working_set.counts.assign(info.num_pages, 0);
+    info.working_set.size = 0;
+    info.program = share_code_ ? a_pcb.getProgram() : -1;
+    info.copy_on_write.assign(info.num_pages, false);
+    if (large_page_pages_ > 0) info.large_pages.assign(info.num_pages / large_page_pages_, -1);
+    info.node = EmptiestNode();
+    info.node_resident.assign(num_nodes_, 0);
+    info.remote_references = 0;
+    info.group = a_pcb.getGroup();
+    if ( (info.program >= 0) && !programs_[info.program].sized ) { //First instance sets how much of the program is code.
+        SharedProgram& program = programs_[info.program];
+        program.code_pages = info.num_pages * code_percent_ / 100;
+        program.code_frames.assign(program.code_pages, -1);
+        program.sized = true;
+    }
+    return info;
+}
+
+size_t Memory::EstimatedWorkingSet(const ProcessMemoryInfo& info) const {
+    if (info.references > 0) return info.working_set.size;
+    return info.num_pages < working_set_window_ ? info.num_pages : working_set_window_;
+}
+
+int Memory::BringInPage(int the_PID, ProcessMemoryInfo& process, int page_number) {
+    int frame = SharedCodeFrame(process, page_number);
+    if (frame != -1) { //Another instance of the program has this code page in memory.
+        MapPage(the_PID, process, page_number, frame, true);
+        ++shared_code_maps_;
+        return frame;
+    }
+    if ( InLargePageRun(process, page_number) && ((groups_ == nullptr) || groups_->RoomFor(process.group, large_page_pages_)) ) {
+        int run = page_number / large_page_pages_;
+        if ( MapLargePage(the_PID, process, run) ) {
+            ++large_faults_;
+            return process.large_pages[run] + page_number % large_page_pages_;
+        }
+    }
+    frame = AllocateFrame(process.node, process.group);
+    if ( (process.program >= 0) && ((size_t)page_number < programs_[process.program].code_frames.size()) ) {
+        MapPage(the_PID, process, page_number, frame, true); //Code pages stay shareable until written.
+        programs_[process.program].code_frames[page_number] = frame;
+        frame_code_[frame] = std::make_pair(process.program, page_number);
+    } else
+        MapPage(the_PID, process, page_number, frame, false);
+    if ( InLargePageRun(process, page_number) ) { //This page may complete a run that can be promoted.
+        PromoteRun(the_PID, process, page_number / large_page_pages_);
+        frame = LookupFrame(the_PID, process, page_number, false);
+    }
+    return frame;
+}
+
+int Memory::LookupFrame(int the_PID, const ProcessMemoryInfo& process, int page_number, bool translate) const {
+    if (large_page_pages_ > 0) {
+        size_t run = page_number / large_page_pages_;
+        if ( (run < process.large_pages.size()) && (process.large_pages[run] != -1) ) {
+            if (translate) ++large_translations_;
+            return process.large_pages[run] + page_number % large_page_pages_;
+        }
+    }
+    return translate ? page_table_->Translate(the_PID, page_number) : page_table_->Lookup(the_PID, page_number);
+}
+
+bool Memory::InLargePageRun(const ProcessMemoryInfo& process, int page_number) const {
+    if (large_page_pages_ == 0) return false;
+    size_t run_start = page_number - page_number % large_page_pages_;
+    if (run_start + large_page_pages_ > process.num_pages) return false; //The partial run at the end stays in base pages.
+    if ( (process.program >= 0) && (run_start < programs_[process.program].code_frames.size()) ) return false; //Shared code
+    return true;
+}
+
+int Memory::FindFreeBlock(int node) const {
+    if (free_frames_ < large_page_pages_) return -1;
+    size_t num_blocks = num_pages_ / large_page_pages_;
+    size_t first_block = (node * num_pages_ / num_nodes_ + large_page_pages_ - 1) / large_page_pages_;
+    for (size_t n = 0; n < num_blocks; ++n) { //From the first block on node, wrapping around to the other nodes.
+        size_t block = ((first_block + n) % num_blocks) * large_page_pages_;
+        size_t i = 0;
+        while ( (i < large_page_pages_) && (frame_ref_count_[block + i] == 0) ) ++i;
+        if (i == large_page_pages_) return block;
+    }
+    return -1;
+}
+
+bool Memory::MapLargePage(int the_PID, ProcessMemoryInfo& process, int run) {
+    int first_page = run * large_page_pages_;
+    for (size_t i = 0; i < large_page_pages_; ++i)
+        if (page_table_->Lookup(the_PID, first_page + i) != -1) return false;
+    int block = FindFreeBlock(process.node);
+    if (block == -1) return false;
+    for (size_t i = 0; i < large_page_pages_; ++i) {
+        frame_ref_count_[block + i] = 1;
+        frame_list_[block + i] = std::make_pair(the_PID, first_page + (int)i);
+        ++process.node_resident[NodeOfFrame(block + i)];
+    }
+    for (int node = NodeOfFrame(block); node <= NodeOfFrame(block + large_page_pages_ - 1); ++node) {
+        std::deque<size_t>& free_list = free_frame_lists_[node];
+        free_list.erase( std::remove_if(free_list.begin(), free_list.end(),
+                                        [&](size_t frame) { return frame_ref_count_[frame] != 0; }),
+                         free_list.end() );
+    }
+    free_frames_ -= large_page_pages_;
+    process.large_pages[run] = block;
+    process.resident += large_page_pages_;
+    if (groups_ != nullptr) groups_->ChargeFrames(process.group, large_page_pages_);
+    return true;
+}
+
+void Memory::PromoteRun(int the_PID, ProcessMemoryInfo& process, int run) {
+    if (process.large_pages[run] != -1) return;
+    int first_page = run * large_page_pages_;
+    for (size_t i = 0; i < large_page_pages_; ++i) {
+        int frame = page_table_->Lookup(the_PID, first_page + i);
+        if ( (frame == -1) || (frame_ref_count_[frame] != 1) || process.copy_on_write[first_page + i] ) return;
+    }
+    if (FindFreeBlock(process.node) == -1) return;
+    for (size_t i = 0; i < large_page_pages_; ++i) //Copy the pages into the block: their old frames become free.
+        UnmapPage(the_PID, process, first_page + i);
+    MapLargePage(the_PID, process, run);
+    ++promotions_;
+}
+
+void Memory::DemoteRun(int the_PID, ProcessMemoryInfo& process, int run) {
+    int block = process.large_pages[run];
+    if (block == -1) return;
+    process.large_pages[run] = -1;
+    for (size_t i = 0; i < large_page_pages_; ++i)
+        page_table_->Map(the_PID, run * large_page_pages_ + i, block + i);
+    ++demotions_;
+}
+
+void Memory::DemoteAll(int the_PID, ProcessMemoryInfo& process) {
+    for (size_t run = 0; run < process.large_pages.size(); ++run)
+        DemoteRun(the_PID, process, run);
+}
+
+int Memory::CopyOnWrite(int the_PID, ProcessMemoryInfo& process, int page_number) {
+    ++copy_on_write_faults_;
+    int frame = page_table_->Lookup(the_PID, page_number);
+    if (frame_ref_count_[frame] == 1) { //No one else maps the frame any more: write it in place.
+        process.copy_on_write[page_number] = false;
+        ForgetCodeFrame(frame);
+        return frame;
+    }
+    if ( !demand_paging_ && (free_frames_ == 0) ) { //Pre-paging never replaces a page: the page stays shared.
+        ++writes_refused_;
+        return frame;
+    }
+    UnmapPage(the_PID, process, page_number); //First, so the frame AllocateFrame() may evict is no longer this page's.
+    frame = AllocateFrame(process.node, process.group);
+    MapPage(the_PID, process, page_number, frame, false);
+    ++pages_copied_;
+    return frame;
+}
+
+int Memory::AllocateFrame(int node, int group) {
+    if ( !demand_paging_ && (free_frames_ == 0) ) return -1; //Pre-paging never replaces a page.
+    int full_group = (groups_ != nullptr && demand_paging_) ? groups_->FullGroup(group) : -1;
+    if (full_group != -1) { //The group replaces its own pages, leaving the frames of other groups alone.
+        int victim = GroupVictim(full_group);
+        if (victim != -1) {
+            groups_->CountLimitEviction(full_group);
+            EvictFrame(victim);
+        }
+    }
+    if (free_frames_ == 0) { //Clock algorithm: skip frames referenced since the hand last passed, clearing their bit.
+        while (frame_referenced_[clock_hand_]) {
+            frame_referenced_[clock_hand_] = false;
+            clock_hand_ = (clock_hand_ + 1) % frame_list_.size();
+        }
+        int victim = clock_hand_;
+        clock_hand_ = (clock_hand_ + 1) % frame_list_.size();
+        EvictFrame(victim); //Puts the victim on the free frame list of its node.
+    }
+    if (numa_policy_ == 'i') {
+        node = next_interleave_node_;
+        next_interleave_node_ = (next_interleave_node_ + 1) % num_nodes_;
+    }
+    int wanted = node;
+    while ( free_frame_lists_[node].empty() ) node = (node + 1) % num_nodes_;
+    if ( (node != wanted) && (numa_policy_ == 'f') ) ++remote_allocations_;
+    int frame = free_frame_lists_[node].front();
+    free_frame_lists_[node].pop_front();
+    --free_frames_;
+    return frame;
+}
+
+int Memory::EmptiestNode() const {
+    int emptiest = 0;
+    for (size_t node = 1; node < num_nodes_; ++node)
+        if (free_frame_lists_[node].size() > free_frame_lists_[emptiest].size()) emptiest = node;
+    return emptiest;
+}
+
+void Memory::EvictFrame(int frame) {
+    ++evictions_;
+    if (frame_ref_count_[frame] == 1) {
+        auto owner = processes_.find(frame_list_[frame].first);
+        if (owner == processes_.end()) return;
+        int page = frame_list_[frame].second;
+        if ( InLargePageRun(owner->second, page) ) //Memory is short: split the large page and evict only this frame.
+            DemoteRun(owner->first, owner->second, page / large_page_pages_);
+        UnmapPage(owner->first, owner->second, page);
+        return;
+    }
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter) { //Shared: every page table mapping it.
+        std::vector< std::pair<int, int> > pages;
+        page_table_->MappedPages(iter->first, pages);
+        for (size_t i = 0; i < pages.size(); ++i)
+            if (pages[i].second == frame) UnmapPage(iter->first, iter->second, pages[i].first);
+    }
+}
+
+void Memory::MapPage(int the_PID, ProcessMemoryInfo& process, int page_number, int frame, bool copy_on_write) {
+    page_table_->Map(the_PID, page_number, frame);
+    process.copy_on_write[page_number] = copy_on_write;
+    ++process.resident;
+    ++process.node_resident[NodeOfFrame(frame)];
+    if (groups_ != nullptr) groups_->ChargeFrames(process.group, 1);
+    if (frame_ref_count_[frame]++ == 0) frame_list_[frame] = std::make_pair(the_PID, page_number);
+}
+
+void Memory::UnmapPage(int the_PID, ProcessMemoryInfo& process, int page_number) {
+    int frame = page_table_->Lookup(the_PID, page_number);
+    page_table_->Unmap(the_PID, page_number);
+    process.copy_on_write[page_number] = false;
+    --process.resident;
+    --process.node_resident[NodeOfFrame(frame)];
+    if (groups_ != nullptr) groups_->ChargeFrames(process.group, -1);
+    if (--frame_ref_count_[frame] > 0) {
+        if (frame_list_[frame] == std::make_pair(the_PID, page_number)) ReassignFrameOwner(frame);
+        return;
+    }
+    frame_list_[frame] = std::make_pair(-1, -1); //default value signifies that frame is unused. 
+    frame_referenced_[frame] = false;
+    ForgetCodeFrame(frame);
+    free_frame_lists_[NodeOfFrame(frame)].push_back(frame);
+    ++free_frames_;
+}
+
+void Memory::ReassignFrameOwner(int frame) {
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter) {
+        std::vector< std::pair<int, int> > pages;
+        page_table_->MappedPages(iter->first, pages);
+        for (size_t i = 0; i < pages.size(); ++i)
+            if (pages[i].second == frame) {
+                frame_list_[frame] = std::make_pair(iter->first, pages[i].first);
+                return;
+            }
+    }
+}
+
+void Memory::ForgetCodeFrame(int frame) {
+    std::pair<int, int> code = frame_code_[frame];
+    if (code.first == -1) return;
+    programs_[code.first].code_frames[code.second] = -1;
+    frame_code_[frame] = std::make_pair(-1, -1);
+}
+
+int Memory::SharedCodeFrame(const ProcessMemoryInfo& process, int page_number) const {
+    if (process.program < 0) return -1;
+    const std::vector<int>& code_frames = programs_[process.program].code_frames;
+    return (size_t)page_number < code_frames.size() ? code_frames[page_number] : -1;
+}
+
+size_t Memory::PrivateFrames(int the_PID) const {
+    std::vector< std::pair<int, int> > pages;
+    page_table_->MappedPages(the_PID, pages);
+    size_t frames = 0;
+    for (size_t i = 0; i < pages.size(); ++i)
+        if (frame_ref_count_[pages[i].second] == 1) ++frames;
+    auto info = processes_.find(the_PID);
+    if (info != processes_.end())
+        for (size_t run = 0; run < info->second.large_pages.size(); ++run)
+            if (info->second.large_pages[run] != -1) frames += large_page_pages_;
+    return frames;
+}
+
+size_t Memory::LargePagesInUse() const {
+    size_t in_use = 0;
+    for (auto iter = processes_.begin(); iter != processes_.end(); ++iter)
+        for (size_t run = 0; run < iter->second.large_pages.size(); ++run)
+            if (iter->second.large_pages[run] != -1) ++in_use;
+    return in_use;
+}
+
+void Memory::UpdateWorkingSet(WorkingSet& working_set, int page_number) {
+    if ( (page_number < 0) || ((size_t)page_number >= working_set.counts.size()) ) return;
+    working_set.window.push_back(page_number);
+    if (working_set.counts[page_number]++ == 0) ++working_set.size;
+    if (working_set.window.size() > working_set_window_) {
+        int oldest = working_set.window.front();
+        working_set.window.pop_front();
+        if (--working_set.counts[oldest] == 0) --working_set.size;
+    }
+}
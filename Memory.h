@@ -4,6 +4,34 @@
  * Date Created: 5.6.2016
  * Description: Memory stimulates the memory unit that implements paging.
  * Modifications:
+ *   10.18.2026 AssignMemory() and FreeMemory() carry instrumentation probes (see Instrumentation.h).
+ *   10.18.2026 Added ReferencePage(), demand paging with global clock replacement, per-process working-set
+ *              estimation and thrashing detection that throttles admission from the Job Pool.
+ *              Page counts round up (PagesForProcess()).
+ *   10.18.2026 Added the load controller: working-set or page-fault-frequency admission, and suspension/resumption
+ *              of resident processes when memory is overloaded. DisplayLoadControl() shows its decisions.
+ *   10.18.2026 Added the backing store: SwapOut() and SwapIn() move a process's pages out of and back into frames
+ *              at a modeled transfer cost. Suspension and resumption swap. DisplaySwapStats() shows swap traffic.
+ *   10.18.2026 Frames are reference counted and every process has its own page table, so frames can be shared.
+ *              Instances of the same program share code pages, ForkProcess() shares the parent's frames
+ *              copy-on-write, and a write to a copy-on-write page copies it on demand. DisplaySharing() shows savings.
+ *   10.18.2026 Translation goes through page_table_: flat, two-level, three-level or hashed inverted (PageTable.h).
+ *              DisplayTranslation() shows its memory overhead and table entries read per translation.
+ *   10.18.2026 Large pages: an aligned run of base pages of a process can be mapped to an aligned block of frames
+ *              by one entry. Faults take a whole large page when a free block exists; a run of base pages is
+ *              promoted to a large page once it is all in memory; memory pressure, swapping and fork demote.
+ *   10.18.2026 NUMA: frames are split into nodes, each with its own free frame list. Frames are allocated first
+ *              touch or interleaved; PlaceProcess() runs a process on the node holding most of its frames, and
+ *              references to frames on other nodes are remote. DisplayNUMA() shows locality and access time.
+ *   10.18.2026 Added ReserveFrames(): frames can be set aside at system generation for the disk buffer cache.
+ *   10.18.2026 Frame limits of process groups (SetGroups()): a job waits in the Job Pool while its group has no room
+ *              for it, and a group at its limit replaces its own pages instead of taking a free frame.
+ *   10.18.2026 Questions are read from and messages written to the streams given to the constructor. Nothing exits
+ *              the program: AssignMemoryToProcessInJobPool() and GetFrameNumber() report failure to the caller.
+ *   10.18.2026 Pre-paging never replaces a page: ForkProcess() copies the parent's pages at once, and is refused when
+ *              the free frames cannot hold them. A write to a shared page with no free frame to copy it into is refused.
+ *   10.18.2026 InitPaging() asks for the reference pattern of new processes, the references per millisecond and the
+ *              percent of writes, which the Scheduler used to ask among its scheduling options.
 */
 
 #ifndef Memory_h
@@ -14,15 +42,63 @@
 #include <utility>
 #include <set>
 #include <map>
+#include <deque>
+#include <vector>
+#include <string>
+#include <memory>
 #include "PCB.h"
+#include "PageTable.h"
+#include "ProcessGroups.h"
 
 struct GreaterThanBasedOnProcessSize { //Function Object to implement comparator based on process size for the Job Pool (std::set job_pool_)
     bool operator() ( const PCB& lhs, const PCB& rhs) const { return lhs.getSizeOfProcess() >= rhs.getSizeOfProcess(); }
 };
 
+/*
+ * Working set of a process: the distinct pages among its last window references.
+ * counts[page] is how many times page appears in window; size is the number of pages with counts[page] > 0.
+*/
+struct WorkingSet {
+    std::deque<int> window;
+    std::vector<int> counts;
+    size_t size;
+};
+
+struct ProcessMemoryInfo { //Kept for every process that has been admitted into memory.
+    size_t num_pages;
+    size_t resident; //frames currently holding pages of this process
+    unsigned long references;
+    unsigned long faults;
+    double fault_rate; //moving average of faults per reference
+    bool swapped_out; //pages are in the backing store, not in frames
+    bool suspended; //swapped out by the load controller
+    std::vector<int> swapped_pages; //pages written to the backing store by the last swap out
+    unsigned long swaps; //swap outs of this process
+    double swap_time; //ms spent moving this process to and from the backing store
+    WorkingSet working_set;
+    int program; //see PCB::getProgram()
+    std::vector<bool> copy_on_write; //Page is mapped to a frame it may share and must be copied before it is written
+    std::vector<int> large_pages; //Index is page number / large page size. First frame of its block, or -1 if not large.
+    int node; //NUMA node of the CPU it runs on. First-touch allocation takes frames there.
+    std::vector<size_t> node_resident; //Index is NUMA node. Pages of resident held in frames of that node.
+    unsigned long remote_references; //references to frames on another node
+    int group; //process group its frames are charged to
+};
+
+/*
+ * A program whose instances share code pages. The first code_pages pages of every instance are code.
+ * code_frames[page] is the frame holding that code page for all instances, or -1 if no instance has it in memory.
+*/
+struct SharedProgram {
+    std::string name;
+    size_t code_pages;
+    bool sized; //code_pages is set from the size of the first instance admitted
+    std::vector<int> code_frames;
+};
+
 class Memory {
 public:
-	Memory(); //Constructor depends on user input. 
+	Memory(std::istream& in, std::ostream& out); //Constructor depends on user input, read from in. Messages go to out.
 
 	/* Initialize the maxmimum size of a process. Will query user until they enter not larger than total_memory_size_. */
 	void InitMaxProcessSize() ;
@@ -32,6 +108,19 @@ public:
 	*/
 	void InitPageSize();
 
+	/*
+	 * Asks whether to configure advanced memory options. If so, queries paging mode (pre-paging or demand paging),
+	 * the working-set window in references, the reference pattern of new processes with how many references they
+	 * make per millisecond of CPU time and what percent are writes, and for demand paging the load control policy:
+	 * working set (thrashing throttles admission from the Job Pool) or page-fault frequency (lower and upper
+	 * fault-rate thresholds), and whether resident processes are suspended when memory is overloaded. Then queries whether blocked processes
+	 * may be swapped out, the swap victim policy, and the backing store's latency and transfer time per page.
+	 * Then queries whether instances of the same program share code pages and what percent of a program is code.
+	 * Then queries the page table structure and the large page size in base pages. Last, queries the number of
+	 * NUMA nodes and, if more than one, the allocation policy and the local and remote access times.
+	*/
+	void InitPaging();
+
 	/*
 	 * Post-Condition: the PCB associated with this PID is currently assigned memory in frame_list_. It no longer needs this memory.
 	 * Post-Condition: The frames assigned to this PCB are freed.
@@ -59,24 +148,163 @@ public:
 
 	size_t GetTotalMemorySize() const { return total_memory_size_; }
 	size_t GetPageSize() const { return page_size_; }
+	/* Number of pages needed to hold a process of the_size; a partial page counts as a whole page. */
+	size_t PagesForProcess(size_t the_size) const { return (the_size + page_size_ - 1) / page_size_; }
+
+	/*
+	 * The process the_PID references page page_number. Updates its working set and, if the page is not in a frame,
+	 * handles the page fault (shared code frame first, then a free frame, else the clock algorithm picks a victim
+	 * among all frames). A write to a copy-on-write page gives the process its own copy of the page.
+	 * Returns the frame holding the page, or -1 if the_PID has not been admitted into memory.
+	*/
+	int ReferencePage(int the_PID, int page_number, bool write = false);
+
+	/* True if instances of the same program share code pages. */
+	bool CodeSharingEnabled() const { return share_code_; }
+
+	/* Pattern letter of the reference strings of new processes: 's', 't', 'z', 'f', 'm' (mixed) or 'n' (none). */
+	char ReferencePattern() const { return reference_pattern_; }
+	/* Memory references a process makes per millisecond of CPU time. */
+	int ReferencesPerMs() const { return references_per_ms_; }
+	/* Percent of memory references that are writes. */
+	int WritePercent() const { return write_percent_; }
+
+	/* Number of the program called the_name, to be given to PCB::setProgram(). Numbers are handed out on first use. */
+	int ProgramID(const std::string& the_name);
+
+	/*
+	 * Admits the_child as a copy of the_parent_PID: the child's page table maps the parent's frames and every
+	 * shared page becomes copy-on-write in both. Takes no frames. Without demand paging the child gets its own copy
+	 * of every page but the shared code pages at once. Returns false if the parent is not in memory, or if without
+	 * demand paging the free frames cannot hold the copies.
+	*/
+	bool ForkProcess(int the_parent_PID, const PCB& the_child);
+
+	/* Prints frames shared and the frames sharing saves, forks, and copy-on-write faults and copies. */
+	void DisplaySharing() const;
+
+	/*
+	 * Prints the page table structure, the memory it takes up, translations and table entries read per translation,
+	 * and large pages in use, page table entries they save, promotions and demotions.
+	*/
+	void DisplayTranslation() const;
+
+	/* Most frames ReserveFrames() may take: all but those the largest process needs. */
+	size_t ReservableFrames() const;
+
+	/*
+	 * Pre-Condition: no process has been admitted and num_frames <= ReservableFrames().
+	 * Takes the last num_frames frames out of memory for use outside of paging, such as the disk buffer cache.
+	 * Memory for processes shrinks by as much.
+	*/
+	void ReserveFrames(size_t num_frames);
+
+	/* Number of NUMA nodes. Frames are split evenly between them, in frame order. */
+	size_t NumNodes() const { return num_nodes_; }
+
+	/*
+	 * the_PID is about to run in the CPU. Runs it on the node holding most of its frames, so that its references
+	 * are local; a process with no frames yet stays where it is. Returns the node.
+	*/
+	int PlaceProcess(int the_PID);
 
-	/* Return true if there are enough frames in free_frame_list_ for a process waiting in the Job Pool. */
+	/* Prints free frames per node, the allocation policy, local and remote references, and memory access time. */
+	void DisplayNUMA() const;
+
+	/* Sum of the working-set estimates of all processes in memory. */
+	size_t WorkingSetDemand() const;
+
+	/*
+	 * Memory is thrashing when the working sets of the processes in memory need more frames than exist. Only with
+	 * demand paging: pre-paging admits a process only when all its pages fit.
+	*/
+	bool Thrashing() const { return demand_paging_ && (WorkingSetDemand() > num_pages_); }
+
+	/* Prints references, page faults and working-set size for every process in memory, then system totals. */
+	void DisplayWorkingSets() const;
+
+	/* True if the load controller may suspend resident processes. Only with demand paging. */
+	bool LoadControlEnabled() const { return demand_paging_ && suspend_when_overloaded_; }
+
+	/*
+	 * Working-set policy: memory is overloaded when it is thrashing.
+	 * Page-fault-frequency policy: memory is overloaded when the recent fault rate is above the upper threshold.
+	*/
+	bool Overloaded() const;
+
+	/* Returns the PID among candidates whose suspension frees the most frames, or -1 if there is none in memory. */
+	int ChooseSuspendVictim(const std::vector<int>& candidates) const;
+
+	/* Swaps the_PID out for the load controller. Its working set is kept so it can be resumed later. */
+	void SuspendProcess(int the_PID);
+
+	/* True if swapped-out process the_PID can be given memory again under the load control policy. */
+	bool CanResume(int the_PID) const;
+
+	/* Pre-Condition: CanResume(the_PID). Swaps the_PID back in. */
+	void ResumeProcess(int the_PID);
+
+	/* True if blocked processes may be swapped out to make room for processes waiting for memory. */
+	bool SwappingEnabled() const { return swapping_; }
+	/* 'b': swap out the blocked process with the longest wait ahead of it. 'l': the one holding the most memory. */
+	char SwapVictimPolicy() const { return swap_victim_policy_; }
+
+	/*
+	 * Writes every resident page of the_PID to the backing store and returns the frames it alone used to
+	 * the free frame lists. Costs swap latency plus transfer time per page.
+	*/
+	void SwapOut(int the_PID);
+
+	/* Pre-Condition: IsSwappedOut(the_PID). Reads the pages of the_PID back into frames. Same cost as SwapOut(). */
+	void SwapIn(int the_PID);
+
+	bool IsSwappedOut(int the_PID) const;
+
+	/* How much memory swapping out the_PID gives back: its unshared frames (pre-paging) or its working set (demand paging). */
+	size_t SwapOutGain(int the_PID) const;
+
+	/*
+	 * Frames that must be given back before the easiest job in the Job Pool can be admitted; 0 if one can be, or if
+	 * no job's group has room for it.
+	*/
+	size_t FramesShortForJobPool() const;
+
+	/* Frames that must be given back before swapped-out process the_PID can be swapped in; 0 if it can be. */
+	size_t FramesShortToSwapIn(int the_PID) const;
+
+	size_t JobPoolSize() const { return job_pool_.size(); }
+
+	/* Prints swap traffic: swap outs and ins, pages moved, time spent and backing store occupancy. */
+	void DisplaySwapStats() const;
+
+	/* Prints the load control policy, recent fault rate, multiprogramming level and the decisions made so far. */
+	void DisplayLoadControl() const;
+
+	/*
+	 * Frames held by processes are charged to their groups in groups, whose frame limits admission and page
+	 * replacement then keep to. Without groups (the default) there are no limits.
+	*/
+	void SetGroups(ProcessGroups* groups) { groups_ = groups; }
+
+	/* True if a_pcb needs more frames to be admitted than the frame limit of its group allows at all. */
+	bool ExceedsGroupLimit(const PCB& a_pcb) const;
+
+	/* Return true if there are enough free frames for a process waiting in the Job Pool. */
 	bool MemoryForWaitingProcesses() const; 
 
 	/* Return true if process the_PID is in Job Pool. */
 	bool ProcessInJobPool(int the_PID) const;
 
 	/* 
-	 * Pre-Condition: There are enough free frames for a process in the Job Pool to be assigned frames.
 	 * Post-Condition: The largest job that will fit has been assigned memory. These frames have been taken 
 	 * 				out of free frame list and the job has been taken out of job pool. 
-	 * Returns the job that has been assigned memory. 
+	 * Sets ready_pcb to the job that has been assigned memory and returns true, or returns false if no job fits.
 	*/
-	PCB AssignMemoryToProcessInJobPool(); 
+	bool AssignMemoryToProcessInJobPool(PCB& ready_pcb); 
 
 	/**
 	  * Calculates the physical address from logical address of a given process. 
-	  * Returns the decimal value of the physical address. 
+	  * Returns the decimal value of the physical address, or -1 if that page is not in memory. 
 	 */
 	int CalculatePhysicalAddress(const int& logical_address, const int& PID) const;
 	/**
@@ -85,19 +313,158 @@ public:
     void DisplayPhysicalAddress(int logical_address, int PID) const ; 
     /**
       * Returns the frame number associated with this page number of this process. 
-      * Pre-Condition: This process has been allocated memory. If not, a call to this process will exit the program.  
+      * Returns -1 if this page of this process has not been allocated memory.
      */
     int GetFrameNumber(const int& page_number, const int& PID) const; 
 
 private:
+    /* Returns the frame holding this page of this process, or -1 if it is not in memory. */
+    int FindFrame(int page_number, int PID) const;
+    /* True if a_pcb may be admitted now: enough free frames (pre-paging) or room for its working set (demand paging). */
+    bool FitsInMemory(const PCB& a_pcb) const;
+    /* Frames a_pcb needs to be admitted: every page it cannot share (pre-paging) or its working-set estimate. */
+    size_t AdmissionFrames(const PCB& a_pcb) const;
+    /*
+     * True if the groups of a_pcb have room for it under their frame limits: the frames their processes hold
+     * (pre-paging) or the working sets of their processes in memory (demand paging), and AdmissionFrames().
+    */
+    bool FitsInGroup(const PCB& a_pcb) const;
+    /* Sum of the working-set estimates of the processes in memory under group. */
+    size_t GroupWorkingSetDemand(int group) const;
+    /* Frame the clock algorithm picks among those held under group, or -1 if the group holds none it can replace. */
+    int GroupVictim(int group);
+    /* Frames a_pcb needs to have every page in memory: its pages, less the code pages it can share. */
+    size_t FramesNeeded(const PCB& a_pcb) const;
+    /* Admits a_pcb: pre-paging assigns a frame to every page; demand paging assigns frames as pages are referenced. */
+    void LoadPages(const PCB& a_pcb);
+    /* Memory information for a process a_pcb being admitted, with nothing in memory yet. */
+    ProcessMemoryInfo NewProcessInfo(const PCB& a_pcb);
+    /* Working-set estimate for a process: its measured working set, or before it has run, its pages capped at the window. */
+    size_t EstimatedWorkingSet(const ProcessMemoryInfo& info) const;
+    /* Demand paging admission test of the load control policy for a process needing working_set frames. */
+    bool AdmissionAllowed(size_t working_set) const;
+    /* Frames short of admitting a process with num_pages pages (pre-paging) or working set working_set (demand paging). */
+    size_t FramesShort(size_t num_pages, size_t working_set) const;
+    /*
+     * Maps page_number of the_PID to its program's shared code frame, or else to a new frame; the whole large page
+     * around it if a free block is available. Returns the frame.
+    */
+    int BringInPage(int the_PID, ProcessMemoryInfo& process, int page_number);
+    /* Frame holding page_number of process, large or not, or -1. translate counts it as a translation. */
+    int LookupFrame(int the_PID, const ProcessMemoryInfo& process, int page_number, bool translate) const;
+    /* True if page_number lies in a run of pages that may be mapped as a large page: private data of a big process. */
+    bool InLargePageRun(const ProcessMemoryInfo& process, int page_number) const;
+    /* First frame of an aligned block of free frames the size of a large page, or -1. Blocks on node come first. */
+    int FindFreeBlock(int node) const;
+    /* Maps large page run to a free block. Returns false if a page of the run is mapped or no block is free. */
+    bool MapLargePage(int the_PID, ProcessMemoryInfo& process, int run);
+    /* If every page of run is in its own private frame, moves them into a free block and maps it as a large page. */
+    void PromoteRun(int the_PID, ProcessMemoryInfo& process, int run);
+    /* Splits large page run back into base pages, each mapped by its own page table entry. */
+    void DemoteRun(int the_PID, ProcessMemoryInfo& process, int run);
+    void DemoteAll(int the_PID, ProcessMemoryInfo& process);
+    /*
+     * Gives the_PID its own copy of copy-on-write page page_number. Without demand paging and no free frame, the write
+     * is refused and the page stays shared. Returns the frame holding the page.
+    */
+    int CopyOnWrite(int the_PID, ProcessMemoryInfo& process, int page_number);
+    /*
+     * Takes a free frame: on node for first touch (another node if node has none), on the next node in turn for
+     * interleave. If group is at a frame limit, a frame held under the full group is evicted first; else if no frame
+     * is free, the clock algorithm evicts a frame from every page table mapping it. Without demand paging nothing is
+     * evicted: returns -1 if no frame is free.
+    */
+    int AllocateFrame(int node, int group);
+    int NodeOfFrame(size_t frame) const { return frame * num_nodes_ / num_pages_; }
+    /* Node with the most free frames, where a new process is placed. */
+    int EmptiestNode() const;
+    void EvictFrame(int frame);
+    void MapPage(int the_PID, ProcessMemoryInfo& process, int page_number, int frame, bool copy_on_write);
+    /* Removes page_number from the page table of the_PID. A frame no page table maps any more is freed. */
+    void UnmapPage(int the_PID, ProcessMemoryInfo& process, int page_number);
+    /* frame_list_[frame] names a page table entry mapping frame; finds another when that one is removed. */
+    void ReassignFrameOwner(int frame);
+    /* frame no longer holds an unmodified code page of a program, so new instances must not share it. */
+    void ForgetCodeFrame(int frame);
+    /* Frame holding the shared code page page_number of process's program, or -1 if there is none. */
+    int SharedCodeFrame(const ProcessMemoryInfo& process, int page_number) const;
+    /* Frames only the_PID maps, given back if it leaves memory. */
+    size_t PrivateFrames(int the_PID) const;
+    size_t LargePagesInUse() const;
+    void UpdateWorkingSet(WorkingSet& working_set, int page_number);
+
+    std::istream& in_; //Answers to the questions asked
+    std::ostream& out_; //Questions and messages
 	size_t total_memory_size_; 
     size_t page_size_; 
     size_t max_size_process_;
     size_t num_pages_; 
     size_t max_pages_per_process_;
-    std::deque<size_t> free_frame_list_; 
+    size_t reserved_frames_; //taken out of memory by ReserveFrames()
+    std::vector< std::deque<size_t> > free_frame_lists_; //Index is NUMA node.
+    size_t free_frames_; //in all free_frame_lists_
     std::vector< std::pair<int, int> > frame_list_; //Index is frame number. First int is PID, second int is page number. 
+    std::vector<int> frame_ref_count_; //Index is frame number. Number of page table entries mapping the frame.
+    std::vector< std::pair<int, int> > frame_code_; //Index is frame number. Program and code page it holds, or (-1, -1).
+    char page_table_kind_; //'f' flat, '2' two-level, '3' three-level, 'h' hashed inverted
+    std::unique_ptr<PageTable> page_table_; //Maps (PID, page number) to frame for every process in memory
+    size_t large_page_pages_; //Base pages per large page; 0 if large pages are not used
+    mutable unsigned long large_translations_; //translations through a large page, one entry read each
+    unsigned long large_faults_; //faults that mapped a whole large page
+    unsigned long promotions_; //runs of base pages moved into a large page
+    unsigned long demotions_;
+    size_t num_nodes_;
+    char numa_policy_; //'f' first touch, 'i' interleave
+    int next_interleave_node_;
+    int local_access_ns_;
+    int remote_access_ns_;
+    unsigned long local_references_;
+    unsigned long remote_references_;
+    unsigned long remote_allocations_; //first-touch allocations that found the process's node full
+    unsigned long node_moves_; //times PlaceProcess() moved a process to another node
     std::set<PCB, GreaterThanBasedOnProcessSize > job_pool_; //Stores the processes waiting to be assigned memory. Initially empty. 
+    bool demand_paging_; //false: every page is given a frame at admission (pre-paging)
+    size_t working_set_window_; //in references
+    char reference_pattern_; //Pattern letter given to new processes: 's', 't', 'z', 'f', 'm' (mixed) or 'n' (none)
+    int references_per_ms_; //Memory references a process makes per millisecond of CPU time
+    int write_percent_; //Percent of memory references that are writes
+    bool throttle_when_thrashing_;
+    char load_policy_; //'w' working set, 'p' page-fault frequency
+    double pff_lower_; //faults per reference
+    double pff_upper_;
+    bool suspend_when_overloaded_;
+    double recent_fault_rate_; //moving average over about working_set_window_ references
+    std::map<int, ProcessMemoryInfo> processes_; //Key is PID. Processes that have been admitted into memory. 
+    std::vector<bool> frame_referenced_; //Reference bit per frame for the clock algorithm
+    size_t clock_hand_;
+    unsigned long total_references_;
+    unsigned long total_faults_;
+    unsigned long evictions_;
+    unsigned long throttled_admissions_; //Admissions refused by the load control policy
+    unsigned long admissions_;
+    unsigned long suspensions_;
+    unsigned long resumptions_;
+    bool swapping_;
+    char swap_victim_policy_;
+    size_t swap_latency_; //ms per swap operation
+    size_t swap_time_per_page_; //ms
+    unsigned long swap_outs_;
+    unsigned long swap_ins_;
+    unsigned long pages_swapped_out_;
+    unsigned long pages_swapped_in_;
+    double swap_time_; //ms, all processes
+    size_t backing_store_pages_; //pages currently held in the backing store
+    size_t peak_backing_store_pages_;
+    bool share_code_;
+    size_t code_percent_; //percent of a program's pages that are code
+    std::vector<SharedProgram> programs_; //Index is program number
+    std::map<std::string, int> program_ids_;
+    unsigned long forks_;
+    unsigned long shared_code_maps_; //page faults resolved by mapping a frame another instance already holds
+    unsigned long copy_on_write_faults_;
+    unsigned long pages_copied_; //copy-on-write faults that needed a new frame
+    unsigned long writes_refused_; //copy-on-write faults left shared because pre-paging had no free frame
+    ProcessGroups* groups_; //Frame limits and charges of the process groups; null if processes are not grouped
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "Multiprocessor.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <set>
+#include <tuple>
+
+/********************Utility Functions********************/
+namespace MultiprocessorNamespace {
+
+const double kNoWork = 1e-9; //Work left of at most this many ms is none: what the rates leave over from rounding
+
+//Mean of total over count, or "--" if there is nothing to average.
+void PrintMean(std::ostream& out, int width, double total, int count) {
+    if (count == 0) out << std::setw(width) << "--";
+    else out << std::setw(width) << total / count;
+}
+
+} //end MultiprocessorNamespace
+
+/********************Public Member Functions********************/
+
+Multiprocessor::Multiprocessor(int num_CPUs) : num_CPUs_(num_CPUs), num_bursts_(0), work_ms_(0.0) {}
+
+void Multiprocessor::RecordBurst(int gang, int PID, double burst_ms) {
+    bursts_[gang][PID].push_back(burst_ms);
+    ++num_bursts_;
+    work_ms_ += burst_ms;
+}
+
+void Multiprocessor::Display(std::ostream& out) const {
+    using MultiprocessorNamespace::PrintMean;
+    int num_threaded = 0, num_single = 0;
+    unsigned long num_threads = 0;
+    for (auto iter = bursts_.begin(); iter != bursts_.end(); ++iter) {
+        if (iter->second.size() > 1) {
+            ++num_threaded;
+            num_threads += iter->second.size();
+        } else
+            ++num_single;
+    }
+    out << "   Multiprocessor model: " << std::dec << num_CPUs_ << " CPUs  Gangs: " << bursts_.size() << " ("
+        << num_threaded << " of " << num_threads << " threads)  Bursts: " << num_bursts_ << "  CPU time: " << work_ms_
+        << " ms\n";
+    Outcome outcomes[2] = { Replay(kGang), Replay(kIndependentSJF) };
+    const char* names[2] = { "Gang", "Independent SJF" };
+    out << std::setw(18) << "Policy|" << std::setw(11) << "Makespan|" << std::setw(16) << "Threaded Done|"
+        << std::setw(14) << "Single Done|" << std::setw(7) << "Util|" << std::setw(12) << "Peer Wait|"
+        << std::setw(15) << "Barrier Idle|" << std::setw(13) << "Fragmented|" << std::setw(11) << "Backfills"
+        << std::endl;
+    for (int i = 0; i < 2; ++i) {
+        const Outcome& outcome = outcomes[i];
+        double capacity = num_CPUs_ * outcome.makespan;
+        out << std::setw(17) << names[i] << std::setw(11) << outcome.makespan;
+        PrintMean(out, 16, outcome.threaded_completion, num_threaded);
+        PrintMean(out, 14, outcome.single_completion, num_single);
+        out << std::setw(6) << int(capacity > 0 ? 100.0 * work_ms_ / capacity + 0.5 : 0.0) << "%" << std::setw(12)
+            << outcome.peer_wait << std::setw(15) << outcome.barrier_idle << std::setw(13) << outcome.fragmented
+            << std::setw(11) << outcome.backfills << std::endl;
+    }
+    out << "   Done times are means over the gangs of several threads and of one thread. Times are in ms.\n";
+    if (outcomes[kGang].threaded_completion > 0)
+        out << "   Gangs of several threads take " << outcomes[kIndependentSJF].threaded_completion
+                                                      / outcomes[kGang].threaded_completion
+            << " times as long to complete under independent SJF as under gang scheduling." << std::endl;
+}
+
+/********************Private Member Functions********************/
+
+std::vector<Multiprocessor::Gang> Multiprocessor::StartGangs() const {
+    std::vector<Gang> gangs;
+    for (auto iter = bursts_.begin(); iter != bursts_.end(); ++iter) {
+        Gang gang;
+        for (auto thread = iter->second.begin(); thread != iter->second.end(); ++thread) {
+            const std::vector<double>& bursts = thread->second;
+            if ( gang.rounds.size() < bursts.size() ) gang.rounds.resize( bursts.size() );
+            for (size_t k = 0; k < bursts.size(); ++k)
+                gang.rounds[k].push_back(bursts[k]);
+        }
+        gang.next_round = 0;
+        NextRound(gang, 0.0);
+        gangs.push_back(gang);
+    }
+    return gangs;
+}
+
+bool Multiprocessor::NextRound(Gang& gang, double now) const {
+    while ( gang.next_round < gang.rounds.size() ) {
+        gang.left = gang.rounds[gang.next_round++];
+        gang.unfinished = 0;
+        for (size_t i = 0; i < gang.left.size(); ++i)
+            if (gang.left[i] > MultiprocessorNamespace::kNoWork) ++gang.unfinished;
+        if (gang.unfinished > 0) {
+            gang.width = std::min<int>(gang.left.size(), num_CPUs_);
+            gang.round_left = *std::max_element( gang.left.begin(), gang.left.end() );
+            return true;
+        }
+    }
+    gang.unfinished = 0;
+    gang.completed = now;
+    return false;
+}
+
+Multiprocessor::Outcome Multiprocessor::Replay(Policy policy) const {
+    using MultiprocessorNamespace::kNoWork;
+    Outcome outcome = Outcome();
+    std::vector<Gang> gangs = StartGangs();
+    std::vector<int> running; //gangs with work left
+    for (size_t g = 0; g < gangs.size(); ++g)
+        if (gangs[g].unfinished > 0) running.push_back(g);
+    double now = 0.0;
+
+    if (policy == kIndependentSJF) {
+        std::set< std::tuple<double, int, int> > ready; //(work left in its round, gang, thread), least work first
+        for (size_t i = 0; i < running.size(); ++i)
+            for (size_t t = 0; t < gangs[running[i]].left.size(); ++t)
+                if (gangs[ running[i] ].left[t] > kNoWork)
+                    ready.insert( std::make_tuple(gangs[ running[i] ].left[t], running[i], t) );
+        while ( !ready.empty() ) {
+            std::vector< std::tuple<double, int, int> > on_CPUs;
+            std::map<int, int> on_CPUs_of_gang;
+            for (auto iter = ready.begin(); (iter != ready.end()) && (on_CPUs.size() < (size_t)num_CPUs_); ++iter) {
+                on_CPUs.push_back(*iter);
+                ++on_CPUs_of_gang[ std::get<1>(*iter) ];
+            }
+            //A thread progresses at the rate of the share of its unfinished peers running with it.
+            std::vector<double> rates;
+            double step = std::numeric_limits<double>::max();
+            for (size_t i = 0; i < on_CPUs.size(); ++i) {
+                int g = std::get<1>(on_CPUs[i]);
+                rates.push_back( double(on_CPUs_of_gang[g]) / std::min(gangs[g].unfinished, num_CPUs_) );
+                step = std::min(step, std::get<0>(on_CPUs[i]) / rates.back());
+            }
+            now += step;
+            std::vector<int> round_over;
+            for (size_t i = 0; i < on_CPUs.size(); ++i) {
+                int g = std::get<1>(on_CPUs[i]), t = std::get<2>(on_CPUs[i]);
+                ready.erase(on_CPUs[i]);
+                outcome.peer_wait += (1.0 - rates[i]) * step;
+                gangs[g].left[t] -= rates[i] * step;
+                if (gangs[g].left[t] > kNoWork)
+                    ready.insert( std::make_tuple(gangs[g].left[t], g, t) );
+                else if (--gangs[g].unfinished == 0)
+                    round_over.push_back(g);
+            }
+            for (size_t i = 0; i < round_over.size(); ++i) {
+                Gang& gang = gangs[ round_over[i] ];
+                if ( !NextRound(gang, now) ) continue;
+                for (size_t t = 0; t < gang.left.size(); ++t)
+                    if (gang.left[t] > kNoWork) ready.insert( std::make_tuple(gang.left[t], round_over[i], t) );
+            }
+        }
+    } else {
+        std::set< std::pair<double, int> > waiting; //(time until its round ends, gang), shortest round first
+        for (size_t i = 0; i < running.size(); ++i)
+            waiting.insert( std::make_pair(gangs[ running[i] ].round_left, running[i]) );
+        while ( !waiting.empty() ) {
+            //Shortest round first; a gang too wide for the CPUs left is passed over for narrower ones behind it.
+            std::vector<int> dispatched;
+            int free_CPUs = num_CPUs_;
+            bool passed_over = false;
+            for (auto iter = waiting.begin(); (iter != waiting.end()) && (free_CPUs > 0); ++iter) {
+                if (gangs[iter->second].width > free_CPUs) {
+                    passed_over = true;
+                    continue;
+                }
+                dispatched.push_back(iter->second);
+                free_CPUs -= gangs[iter->second].width;
+                if (passed_over) ++outcome.backfills;
+            }
+            //Each gang runs the threads with the most work left, all of them unless it has more than the CPUs.
+            std::vector< std::pair<int, int> > on_CPUs; //(gang, thread)
+            double step = std::numeric_limits<double>::max();
+            for (size_t i = 0; i < dispatched.size(); ++i) {
+                const Gang& gang = gangs[ dispatched[i] ];
+                std::vector< std::pair<double, int> > threads;
+                for (size_t t = 0; t < gang.left.size(); ++t)
+                    if (gang.left[t] > kNoWork) threads.push_back( std::make_pair(gang.left[t], t) );
+                std::sort( threads.rbegin(), threads.rend() );
+                for (int t = 0; t < std::min<int>(gang.width, threads.size()); ++t) {
+                    on_CPUs.push_back( std::make_pair(dispatched[i], threads[t].second) );
+                    step = std::min(step, threads[t].first);
+                }
+            }
+            now += step;
+            outcome.barrier_idle += (num_CPUs_ - free_CPUs - on_CPUs.size()) * step;
+            if (passed_over) outcome.fragmented += free_CPUs * step;
+            for (size_t i = 0; i < dispatched.size(); ++i)
+                waiting.erase( std::make_pair(gangs[ dispatched[i] ].round_left, dispatched[i]) );
+            for (size_t i = 0; i < on_CPUs.size(); ++i) {
+                double& left = gangs[ on_CPUs[i].first ].left[ on_CPUs[i].second ];
+                left -= step;
+                if (left <= kNoWork) --gangs[ on_CPUs[i].first ].unfinished;
+            }
+            for (size_t i = 0; i < dispatched.size(); ++i) {
+                Gang& gang = gangs[ dispatched[i] ];
+                if ( (gang.unfinished == 0) && !NextRound(gang, now) ) continue;
+                gang.round_left = *std::max_element( gang.left.begin(), gang.left.end() );
+                waiting.insert( std::make_pair(gang.round_left, dispatched[i]) );
+            }
+        }
+    }
+    outcome.makespan = now;
+    for (size_t g = 0; g < gangs.size(); ++g) {
+        if (gangs[g].rounds.front().size() > 1) outcome.threaded_completion += gangs[g].completed;
+        else outcome.single_completion += gangs[g].completed;
+    }
+    return outcome;
+}
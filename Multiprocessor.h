@@ -0,0 +1,77 @@
+/*
+ * Author: Emma Kimlin
+ * Title: Multiprocessor.h
+ * Date Created: 10.18.2026
+ * Description: Model of the system's CPU bursts on several CPUs, comparing gang scheduling of cooperating threads with
+ *              scheduling every thread on its own by SJF. The Scheduler runs one CPU; the model records the bursts it
+ *              runs, by gang, and replays them on the CPUs under both policies when asked, all gangs starting at once.
+ *              The threads of a gang communicate. The k-th bursts of its threads form its k-th round, and the next
+ *              round starts when the last burst of the round ends. A thread makes progress only at the rate of the
+ *              share of its unfinished peers running with it (all of them, or as many as there are CPUs), so a thread
+ *              running while its peers wait for a CPU mostly waits on them.
+ *              Gang scheduling dispatches a gang onto as many CPUs as it has threads in the round at once, shortest
+ *              round first. A gang too wide for the CPUs left waits, and narrower gangs behind it fill the gap, so CPUs
+ *              stay idle only when no waiting gang fits in them. A gang keeps its CPUs until its round ends, even those
+ *              of threads that are done with the round.
+ *              Independent SJF gives the CPUs to the threads with the least work left in their round.
+*/
+
+#ifndef Multiprocessor_h
+#define Multiprocessor_h
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+class Multiprocessor {
+public:
+    explicit Multiprocessor(int num_CPUs);
+
+    int NumCPUs() const { return num_CPUs_; }
+
+    /* Thread PID of gang (a number telling the gangs apart) has finished a CPU burst of burst_ms. */
+    void RecordBurst(int gang, int PID, double burst_ms);
+
+    /**
+      * Replays the bursts recorded under both policies. Prints when the gangs completed under each, the CPU
+      * utilization, and the CPU time lost to threads waiting on their peers, to CPUs held at the end of a round and
+      * to CPUs too few for a waiting gang.
+     */
+    void Display(std::ostream& out) const;
+
+private:
+    enum Policy { kGang, kIndependentSJF };
+    /* Result of replaying the bursts under one policy. Times are in ms. */
+    struct Outcome {
+        double makespan; //until the last round of every gang ended
+        double threaded_completion; //sum, over the gangs of several threads, of the time their last round ended
+        double single_completion; //the same over the gangs of one thread
+        double peer_wait; //CPU time of threads running without all their peers, not making progress
+        double barrier_idle; //CPU time a gang held for its threads done with their round
+        double fragmented; //CPU time idle while a gang waited that was too wide for it
+        unsigned long backfills; //gangs dispatched ahead of a shorter one that did not fit
+    };
+    /* A gang as it is replayed: its rounds, and the work its threads have left in the current one. */
+    struct Gang {
+        std::vector< std::vector<double> > rounds; //rounds[k] holds the k-th burst of every thread that ran k bursts
+        size_t next_round;
+        std::vector<double> left; //work left to each thread in the current round
+        int unfinished; //threads with work left in the current round
+        int width; //CPUs it runs on: its threads in the current round, at most the CPUs
+        double round_left; //most work left to a thread in the current round: time until the round ends
+        double completed; //time its last round ended
+    };
+
+    Outcome Replay(Policy policy) const;
+    /* Gangs of the bursts recorded, in their first rounds. */
+    std::vector<Gang> StartGangs() const;
+    /* Starts the next round of gang with work in it at time now. Returns false, completing gang, if there is none. */
+    bool NextRound(Gang& gang, double now) const;
+
+    int num_CPUs_;
+    std::map<int, std::map<int, std::vector<double> > > bursts_; //bursts_[gang][PID]: bursts of thread PID, in order
+    unsigned long num_bursts_;
+    double work_ms_; //CPU time of the bursts recorded
+};
+
+#endif
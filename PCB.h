@@ -2,7 +2,8 @@
 Author: Emma Kimlin
 Title: PCB.h
 Date Created: 3.2.2016
-Description: PCB (Process Control Block) symbolizes a task that needs to be processed by the CPU. 
+Description: PCB (Process Control Block) symbolizes a task that needs to be processed by the CPU. Each PCB is one
+             schedulable thread; the threads of a process share the address space of the process they were created by.
 Modifications:
     3.5.2016 Added private member variables needed for I/O request. 
                        Added setters. Added print()
@@ -12,6 +13,22 @@ Modifications:
     4.13.2016 Added cylinder_ 
     5.6.2016 Added num_words_
     5.9.2016 Modified setStartAddressFromUser() to only accept hexidecimal input. 
+    10.18.2026 Added reference_string_ so a process generates memory references while it runs.
+               setStartAddressFromUser() rejects a page number equal to num_pages.
+    10.18.2026 Added program_ so instances of the same program can share code pages, and NextReferenceIsWrite().
+    10.18.2026 Added getCylinder() so requests on nearby cylinders can be merged.
+    10.18.2026 Added async_ to mark the copy of a PCB that stands for an asynchronous request in a device queue.
+    10.18.2026 Added ready_since_, ready_key_ and max_wait_ for aging in the Ready Queue.
+    10.18.2026 Added period_, budget_, relative_deadline_, release_ and deadline_ for real-time tasks.
+    10.18.2026 Added address_space_ so threads of one process share its page table and frames.
+    10.18.2026 Grouped the fields the Ready Queue reads at the front and moved the I/O request fields to io_, with the
+               file name in a fixed-size array. num_bursts_ is an int; the average burst is computed when asked for.
+    10.18.2026 A request names its file by its number in the Scheduler's FileTable instead of storing the name.
+    10.18.2026 Added group_, the process group (ProcessGroups.h) whose limits and accounting the process comes under.
+    10.18.2026 Setters that query the user read from and write to the streams they are given. Setters that do not
+               query the user no longer ask again for an invalid value.
+    10.18.2026 Added getCPU_UsageThisBurst() so a burst can be recorded when it ends.
+    10.18.2026 Added setFile() and setLogicalStartAddress() for requests given without querying the user.
 */
 
 #ifndef PCB_h
@@ -20,32 +37,105 @@ Modifications:
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include "ReferenceString.h"
+#include "FileTable.h"
 
 class PCB {
 public:
     PCB(int pid, double next_burst, size_t the_size);
-    /* Setters that query the user. */
-    void setStartAddressFromUser(int num_pages, int page_size);
-    void setFileNameFromUser();
-    void setRead_WriteFromUser();
-    void setFileLenFromUser();
-    /* Setters that do not query user */
-    void setRead_Write (char rw);
-    void setFileLen (int len);
-    void setCylinder(int a_cylinder);
+    /* Setters that query the user: answers are read from in, questions written to out. */
+    void setStartAddressFromUser(std::istream& in, std::ostream& out, int num_pages, int page_size);
+    /* Asks for the file name and keeps its number in files. */
+    void setFileFromUser(std::istream& in, std::ostream& out, FileTable& files);
+    void setRead_WriteFromUser(std::istream& in, std::ostream& out);
+    void setFileLenFromUser(std::istream& in, std::ostream& out);
+    /* Setters that do not query user. Pre-Condition: rw is 'r' or 'w', len >= 0 and a_cylinder >= -1 (none). */
+    void setFile(int a_file) { io_.file = a_file; }
+    void setLogicalStartAddress(int address) { io_.logical_start_address = address; }
+    void setRead_Write (char rw) { io_.read_write = rw; }
+    void setFileLen (int len) { io_.file_length = len; }
+    void setCylinder(int a_cylinder) { io_.cylinder = a_cylinder; }
+    void setReferenceString(const ReferenceString& a_reference_string) { reference_string_ = a_reference_string; }
+    void setProgram(int a_program) { program_ = a_program; }
+    void setAsync(bool is_async) { async_ = is_async; }
+    void setAddressSpace(int a_PID) { address_space_ = a_PID; }
+    void setGroup(int a_group) { group_ = a_group; }
+    /* Makes the process a real-time task releasing a job (one CPU burst) at most every period ms, each job needing
+       budget ms of CPU time within relative_deadline ms of its release. A period of 0 makes it an ordinary process. */
+    void setRealTime(double period, double budget, double relative_deadline) {
+        period_ = period;
+        budget_ = budget;
+        relative_deadline_ = relative_deadline;
+        release_ = -period;
+        deadline_ = -1.0;
+    }
+    /* Place in the Ready Queue at time now (ms), smaller first. An ordinary process: its expected remaining burst,
+       less aging_rate ms per ms waited, as remaining + aging_rate * now so waiters need no updating. A real-time task:
+       the deadline of its job (EDF) or its period (rate-monotonic). */
+    double PriorityKey(double now, double aging_rate, bool rate_monotonic) const {
+        if ( IsRealTime() ) return rate_monotonic ? period_ : deadline_;
+        return expected_next_burst_remaining_ + aging_rate * now;
+    }
+    /* The process enters the Ready Queue at time now. A real-time task without a job releases one, no sooner than a
+       period after the last: the job may run early, but its deadline is counted from that release. */
+    void EnterReadyQueue(double now, double aging_rate, bool rate_monotonic) {
+        ready_since_ = now;
+        if ( IsRealTime() && !HasJob() ) {
+            release_ = (now > release_ + period_) ? now : release_ + period_;
+            deadline_ = release_ + relative_deadline_;
+        }
+        ready_key_ = PriorityKey(now, aging_rate, rate_monotonic);
+    }
+    /* The job of a real-time task finishes its burst at time now. Returns its lateness: negative if it was early. */
+    double CompleteJob(double now) {
+        double lateness = now - deadline_;
+        deadline_ = -1.0;
+        return lateness;
+    }
+    /* The process leaves the Ready Queue at time now. Returns how long it waited. */
+    double LeaveReadyQueue(double now) {
+        double wait = now - ready_since_;
+        if (wait > max_wait_) max_wait_ = wait;
+        return wait;
+    }
     /* Getters */
     int getPID() const { return PID_; }
-    int getLogicalStartAddress() const { return logical_start_address_; }
-    int getRead_Write() const { return read_write_; }
-    int getFileLen() const { return file_length_; }
-    std::string getFileName() const { return filename_; }
+    /* PID of the process whose memory this thread uses: its own PID, unless it is a thread created by another. */
+    int getAddressSpace() const { return address_space_; }
+    /* Process group the process is in; ProcessGroups::kDefaultGroup unless it was placed in one. */
+    int getGroup() const { return group_; }
+    int getLogicalStartAddress() const { return io_.logical_start_address; }
+    int getRead_Write() const { return io_.read_write; }
+    int getFileLen() const { return io_.file_length; }
+    /* Number of the requested file in the Scheduler's FileTable; FileTable::kNoFile if none. */
+    int getFile() const { return io_.file; }
+    int getCylinder() const { return io_.cylinder; }
     double getCPU_Usage() const { return total_CPU_usage_; }
-    double getAvgBurst() const { return avg_burst_time_; }
+    double getCPU_UsageThisBurst() const { return CPU_usage_this_burst_; }
+    double getAvgBurst() const { return num_bursts_ ? total_CPU_usage_ / num_bursts_ : 0.0; }
     double getExpectedNextBurstTotal() const { return expected_next_burst_total_; }
     double getExpectedNextBurstRemaining() const { return expected_next_burst_remaining_;}
     double getSizeOfProcess() const { return size_of_process_; }
-    /* Print all data members of a PCB. Output spacing is formatted and ends in a new line. */
-    void Print();
+    int getProgram() const { return program_; }
+    /* True if this PCB is an asynchronous request; the process itself is elsewhere. */
+    bool IsAsync() const { return async_; }
+    double getReadySince() const { return ready_since_; }
+    double getReadyKey() const { return ready_key_; }
+    double getMaxWait() const { return max_wait_; }
+    bool IsRealTime() const { return period_ > 0; }
+    /* True if a real-time task has released a job that has not finished its burst. */
+    bool HasJob() const { return deadline_ >= 0; }
+    double getPeriod() const { return period_; }
+    double getBudget() const { return budget_; }
+    double getRelativeDeadline() const { return relative_deadline_; }
+    double getDeadline() const { return deadline_; }
+    bool HasReferenceString() const { return reference_string_.getPattern() != ReferenceString::kNone; }
+    /* Next page this process references. Pre-Condition: HasReferenceString(). */
+    int NextPageReference() { return reference_string_.NextPage(); }
+    /* True if the reference just returned by NextPageReference() is a write. */
+    bool NextReferenceIsWrite() { return reference_string_.NextIsWrite(); }
+    /* Print all data members of a PCB to out, the file named as in files. Output spacing is formatted and ends in a new line. */
+    void Print(std::ostream& out, const FileTable& files);
 
     bool operator<(const PCB& rhs) const {
         return expected_next_burst_remaining_ < rhs.expected_next_burst_remaining_ ? true : false;
@@ -61,7 +151,6 @@ public:
         num_bursts_++;
         CPU_usage_this_burst_ += CPU_usage; 
         total_CPU_usage_ += CPU_usage_this_burst_;
-        avg_burst_time_ = total_CPU_usage_/num_bursts_; 
         expected_next_burst_total_ = ((1 - his_param) * expected_next_burst_total_) + (his_param * CPU_usage_this_burst_);
         //Re-set for when the PCB is done with I/O burst and needs to go to Ready Queue:
         expected_next_burst_remaining_ = expected_next_burst_total_;
@@ -76,23 +165,41 @@ public:
     void UpdateBeforeKill() {
         num_bursts_++;
         total_CPU_usage_ += CPU_usage_this_burst_;
-        avg_burst_time_ = total_CPU_usage_/num_bursts_;
     }
 
 private:
-    int PID_;
-    int logical_start_address_;
-    char read_write_;
-    int file_length_;
-    std::string filename_;
+    /* The I/O request a process makes with a system call. Read only by the devices and Snapshot(). */
+    struct IORequest {
+        int file; //number in the FileTable
+        int file_length;
+        int logical_start_address;
+        int cylinder; //will be set to -1 if process is not requesting access to disk I/O
+        char read_write;
+    };
+
+    //Read by every Ready Queue comparison and preemption decision: kept together at the front.
+    double ready_key_; //Ready Queue order, with aging; see EnterReadyQueue()
+    double period_; //Least time between releases of jobs of a real-time task, in ms; 0 if the process is not real-time
+    double expected_next_burst_remaining_; //Used by the Ready Queue Scheduler to implement SJF Scheduling 
+    double deadline_; //Absolute deadline of the current job; -1 if there is none
+    double ready_since_; //Time the process last entered the Ready Queue, in ms of CPU time run by the system
+    int PID_; //Unique to each thread
+    int address_space_; //PID the memory unit knows the page table and frames of this thread by
+    int group_; //Process group: the Ready Queue picks between groups by their CPU share
+    bool async_; //This copy waits in a device queue for an asynchronous request while the process runs on
+    //Updated once per burst.
+    int num_bursts_;
+    int program_; //Program this process is an instance of, as numbered by Memory::ProgramID(); -1 if none
     double total_CPU_usage_; //total time process has used CPU
     double CPU_usage_this_burst_; //time process has used CPU during current burst; must be reset to 0 when burst finishes 
-    double avg_burst_time_;
     double expected_next_burst_total_; 
-    double expected_next_burst_remaining_; //Used by the Ready Queue Scheduler to implement SJF Scheduling 
-    double num_bursts_;
-    int cylinder_; //will be set to -1 if process is not requesting access to disk I/O
+    double max_wait_; //Longest the process has waited in the Ready Queue, in ms
+    double budget_; //CPU time a job needs, in ms
+    double relative_deadline_; //Time after its release by which a job must finish, in ms
+    double release_; //Time the current or last job was released
     size_t size_of_process_; 
+    IORequest io_;
+    ReferenceString reference_string_; //Pages referenced during CPU bursts
 };
 
 #endif
@@ -0,0 +1,264 @@
+#include "PageTable.h"
+#include <algorithm>
+
+/********************PageTable********************/
+
+int PageTable::Translate(int the_PID, int page_number) const {
+    unsigned accesses = 0;
+    int frame = Walk(the_PID, page_number, accesses);
+    ++translations_;
+    accesses_ += accesses;
+    return frame;
+}
+
+int PageTable::Lookup(int the_PID, int page_number) const {
+    unsigned accesses = 0;
+    return Walk(the_PID, page_number, accesses);
+}
+
+PageTable* PageTable::Create(char kind, size_t max_pages, size_t num_frames) {
+    switch (kind) {
+    case '2': return new MultiLevelPageTable(2, max_pages);
+    case '3': return new MultiLevelPageTable(3, max_pages);
+    case 'h': return new HashedPageTable(num_frames);
+    default: return new FlatPageTable;
+    }
+}
+
+/********************FlatPageTable********************/
+
+void FlatPageTable::AddProcess(int the_PID, size_t num_pages) {
+    tables_[the_PID].assign(num_pages, -1);
+}
+
+void FlatPageTable::RemoveProcess(int the_PID) {
+    tables_.erase(the_PID);
+}
+
+void FlatPageTable::Map(int the_PID, int page_number, int frame) {
+    tables_[the_PID][page_number] = frame;
+}
+
+void FlatPageTable::Unmap(int the_PID, int page_number) {
+    tables_[the_PID][page_number] = -1;
+}
+
+void FlatPageTable::MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const {
+    auto table = tables_.find(the_PID);
+    if (table == tables_.end()) return;
+    for (size_t i = 0; i < table->second.size(); ++i)
+        if (table->second[i] != -1) pages.push_back( std::make_pair((int)i, table->second[i]) );
+}
+
+size_t FlatPageTable::OverheadBytes() const {
+    size_t bytes = 0;
+    for (auto iter = tables_.begin(); iter != tables_.end(); ++iter)
+        bytes += iter->second.size() * sizeof(int);
+    return bytes;
+}
+
+int FlatPageTable::Walk(int the_PID, int page_number, unsigned& accesses) const {
+    auto table = tables_.find(the_PID);
+    if ( (table == tables_.end()) || (page_number < 0) || ((size_t)page_number >= table->second.size()) ) return -1;
+    ++accesses;
+    return table->second[page_number];
+}
+
+/********************MultiLevelPageTable********************/
+
+MultiLevelPageTable::MultiLevelPageTable(int levels, size_t max_pages) {
+    levels_ = levels;
+    int page_bits = 0;
+    while ( ((size_t)1 << page_bits) < max_pages ) ++page_bits;
+    bits_per_level_ = (page_bits + levels_ - 1) / levels_;
+    if (bits_per_level_ == 0) bits_per_level_ = 1;
+    live_nodes_ = 0;
+}
+
+void MultiLevelPageTable::AddProcess(int the_PID, size_t) {
+    roots_[the_PID] = NewNode(); //The top-level table always exists.
+}
+
+void MultiLevelPageTable::RemoveProcess(int the_PID) {
+    auto root = roots_.find(the_PID);
+    if (root == roots_.end()) return;
+    FreeTree(root->second, 0);
+    roots_.erase(root);
+}
+
+void MultiLevelPageTable::Map(int the_PID, int page_number, int frame) {
+    int node = roots_[the_PID];
+    for (int level = 0; level < levels_ - 1; ++level) { //Allocate the tables on the way down that are missing.
+        int index = Index(page_number, level);
+        int child = nodes_[node].entries[index];
+        if (child == -1) {
+            child = NewNode(); //May move nodes_, so index it again below.
+            nodes_[node].entries[index] = child;
+            ++nodes_[node].used;
+        }
+        node = child;
+    }
+    nodes_[node].entries[Index(page_number, levels_ - 1)] = frame;
+    ++nodes_[node].used;
+}
+
+void MultiLevelPageTable::Unmap(int the_PID, int page_number) {
+    int path[3];
+    path[0] = roots_[the_PID];
+    for (int level = 0; level < levels_ - 1; ++level) {
+        path[level + 1] = nodes_[path[level]].entries[Index(page_number, level)];
+        if (path[level + 1] == -1) return; //Not mapped.
+    }
+    Node& bottom = nodes_[path[levels_ - 1]];
+    int& entry = bottom.entries[Index(page_number, levels_ - 1)];
+    if (entry == -1) return;
+    entry = -1;
+    --bottom.used;
+    for (int level = levels_ - 1; level > 0; --level) { //Free tables left empty, but never the top one.
+        if (nodes_[path[level]].used > 0) break;
+        FreeNode(path[level]);
+        nodes_[path[level - 1]].entries[Index(page_number, level - 1)] = -1;
+        --nodes_[path[level - 1]].used;
+    }
+}
+
+void MultiLevelPageTable::MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const {
+    auto root = roots_.find(the_PID);
+    if (root != roots_.end()) CollectPages(root->second, 0, 0, pages);
+}
+
+size_t MultiLevelPageTable::OverheadBytes() const {
+    return live_nodes_ * ((size_t)1 << bits_per_level_) * sizeof(int);
+}
+
+int MultiLevelPageTable::Walk(int the_PID, int page_number, unsigned& accesses) const {
+    auto root = roots_.find(the_PID);
+    if ( (root == roots_.end()) || (page_number < 0) ) return -1;
+    if ( (page_number >> (bits_per_level_ * levels_)) != 0 ) return -1;
+    int entry = root->second;
+    for (int level = 0; level < levels_; ++level) { //One entry read per level, fewer if a table is missing.
+        ++accesses;
+        entry = nodes_[entry].entries[Index(page_number, level)];
+        if (entry == -1) return -1;
+    }
+    return entry;
+}
+
+int MultiLevelPageTable::NewNode() {
+    int node;
+    if ( !free_nodes_.empty() ) {
+        node = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        node = nodes_.size();
+        nodes_.push_back(Node());
+    }
+    nodes_[node].entries.assign((size_t)1 << bits_per_level_, -1);
+    nodes_[node].used = 0;
+    ++live_nodes_;
+    return node;
+}
+
+void MultiLevelPageTable::FreeNode(int node) {
+    nodes_[node].entries.clear();
+    nodes_[node].entries.shrink_to_fit();
+    free_nodes_.push_back(node);
+    --live_nodes_;
+}
+
+int MultiLevelPageTable::Index(int page_number, int level) const {
+    return (page_number >> (bits_per_level_ * (levels_ - 1 - level))) & ((1 << bits_per_level_) - 1);
+}
+
+void MultiLevelPageTable::CollectPages(int node, int level, int first_page,
+                                       std::vector< std::pair<int, int> >& pages) const {
+    const std::vector<int>& entries = nodes_[node].entries;
+    int pages_per_entry = 1 << (bits_per_level_ * (levels_ - 1 - level));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i] == -1) continue;
+        int page = first_page + i * pages_per_entry;
+        if (level == levels_ - 1) pages.push_back( std::make_pair(page, entries[i]) );
+        else CollectPages(entries[i], level + 1, page, pages);
+    }
+}
+
+void MultiLevelPageTable::FreeTree(int node, int level) {
+    if (level < levels_ - 1)
+        for (size_t i = 0; i < nodes_[node].entries.size(); ++i)
+            if (nodes_[node].entries[i] != -1) FreeTree(nodes_[node].entries[i], level + 1);
+    FreeNode(node);
+}
+
+/********************HashedPageTable********************/
+
+HashedPageTable::HashedPageTable(size_t num_frames) {
+    size_t num_anchors = 1;
+    while (num_anchors < num_frames) num_anchors <<= 1;
+    anchors_.assign(num_anchors, -1);
+}
+
+void HashedPageTable::RemoveProcess(int the_PID) {
+    for (size_t i = 0; i < entries_.size(); ++i)
+        if (entries_[i].PID == the_PID) Unmap(the_PID, entries_[i].page_number);
+}
+
+void HashedPageTable::Map(int the_PID, int page_number, int frame) {
+    int entry;
+    if ( !free_entries_.empty() ) {
+        entry = free_entries_.back();
+        free_entries_.pop_back();
+    } else {
+        entry = entries_.size();
+        entries_.push_back(Entry());
+    }
+    size_t anchor = Hash(the_PID, page_number);
+    entries_[entry].PID = the_PID;
+    entries_[entry].page_number = page_number;
+    entries_[entry].frame = frame;
+    entries_[entry].next = anchors_[anchor];
+    anchors_[anchor] = entry;
+}
+
+void HashedPageTable::Unmap(int the_PID, int page_number) {
+    int* link = &anchors_[Hash(the_PID, page_number)];
+    while (*link != -1) {
+        Entry& entry = entries_[*link];
+        if ( (entry.PID == the_PID) && (entry.page_number == page_number) ) {
+            int freed = *link;
+            *link = entry.next;
+            entry.PID = -1;
+            free_entries_.push_back(freed);
+            return;
+        }
+        link = &entry.next;
+    }
+}
+
+void HashedPageTable::MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const {
+    size_t first = pages.size();
+    for (size_t i = 0; i < entries_.size(); ++i) //An inverted table has no per-process index: scan every entry.
+        if (entries_[i].PID == the_PID) pages.push_back( std::make_pair(entries_[i].page_number, entries_[i].frame) );
+    std::sort(pages.begin() + first, pages.end());
+}
+
+size_t HashedPageTable::OverheadBytes() const {
+    return anchors_.size() * sizeof(int) + entries_.size() * sizeof(Entry);
+}
+
+int HashedPageTable::Walk(int the_PID, int page_number, unsigned& accesses) const {
+    ++accesses; //anchor
+    for (int entry = anchors_[Hash(the_PID, page_number)]; entry != -1; entry = entries_[entry].next) {
+        ++accesses;
+        if ( (entries_[entry].PID == the_PID) && (entries_[entry].page_number == page_number) )
+            return entries_[entry].frame;
+    }
+    return -1;
+}
+
+size_t HashedPageTable::Hash(int the_PID, int page_number) const {
+    unsigned hash = (unsigned)the_PID * 2654435761u + (unsigned)page_number;
+    hash ^= hash >> 15;
+    hash *= 2246822519u;
+    hash ^= hash >> 13;
+    return hash & (anchors_.size() - 1);
+}
@@ -0,0 +1,141 @@
+/*
+ * Author: Emma Kimlin
+ * Title: PageTable.h
+ * Date Created: 10.18.2026
+ * Description: Translation structures Memory uses to map (PID, page number) to a frame. Each one counts the
+ *              translations made through it and the table entries read doing them, and reports the memory it uses.
+ *              Flat: one array per process, one entry per page.
+ *              Multi-level: two or three levels per process; a table below the top is only allocated once a page
+ *              it covers is mapped, and is freed again when it maps nothing.
+ *              Hashed inverted: one table for the whole system, keyed by (PID, page), sized by the number of frames.
+*/
+
+#ifndef PageTable_h
+#define PageTable_h
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class PageTable {
+public:
+    virtual ~PageTable() {}
+
+    /* Makes an empty table for the_PID, whose pages are numbered [0, num_pages). */
+    virtual void AddProcess(int the_PID, size_t num_pages) = 0;
+    /* Discards the table of the_PID. */
+    virtual void RemoveProcess(int the_PID) = 0;
+    /* Pre-Condition: the_PID was added and page_number is not mapped. */
+    virtual void Map(int the_PID, int page_number, int frame) = 0;
+    virtual void Unmap(int the_PID, int page_number) = 0;
+    /* Appends every (page number, frame) the_PID has mapped to pages, in page order. */
+    virtual void MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const = 0;
+    /* Bytes of memory the tables take up now. */
+    virtual size_t OverheadBytes() const = 0;
+    /* Name and layout, for display. */
+    virtual const char* Name() const = 0;
+
+    /* Frame holding page_number of the_PID, or -1. Counted as a translation. */
+    int Translate(int the_PID, int page_number) const;
+    /* Same as Translate() but not counted; for the memory unit's own bookkeeping. */
+    int Lookup(int the_PID, int page_number) const;
+
+    unsigned long Translations() const { return translations_; }
+    /* Average table entries read per translation. */
+    double AccessesPerTranslation() const { return translations_ ? double(accesses_) / translations_ : 0.0; }
+
+    /*
+     * kind: 'f' flat, '2' two-level, '3' three-level, 'h' hashed inverted. max_pages is the most pages a process
+     * can have; num_frames sizes the hashed table.
+    */
+    static PageTable* Create(char kind, size_t max_pages, size_t num_frames);
+
+protected:
+    PageTable() : translations_(0), accesses_(0) {}
+    /* Frame holding page_number of the_PID, or -1. Adds the table entries read to accesses. */
+    virtual int Walk(int the_PID, int page_number, unsigned& accesses) const = 0;
+
+private:
+    mutable unsigned long translations_;
+    mutable unsigned long accesses_;
+};
+
+class FlatPageTable : public PageTable {
+public:
+    void AddProcess(int the_PID, size_t num_pages);
+    void RemoveProcess(int the_PID);
+    void Map(int the_PID, int page_number, int frame);
+    void Unmap(int the_PID, int page_number);
+    void MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const;
+    size_t OverheadBytes() const;
+    const char* Name() const { return "flat"; }
+protected:
+    int Walk(int the_PID, int page_number, unsigned& accesses) const;
+private:
+    std::unordered_map<int, std::vector<int> > tables_; //Key is PID. Index is page number; -1 if not in memory.
+};
+
+class MultiLevelPageTable : public PageTable {
+public:
+    /* Splits the bits of a page number of a process with max_pages pages evenly over levels (2 or 3) tables. */
+    MultiLevelPageTable(int levels, size_t max_pages);
+    void AddProcess(int the_PID, size_t num_pages);
+    void RemoveProcess(int the_PID);
+    void Map(int the_PID, int page_number, int frame);
+    void Unmap(int the_PID, int page_number);
+    void MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const;
+    size_t OverheadBytes() const;
+    const char* Name() const { return levels_ == 2 ? "two-level" : "three-level"; }
+protected:
+    int Walk(int the_PID, int page_number, unsigned& accesses) const;
+private:
+    /* A table at any level. Entries of the bottom table are frames; entries above are node numbers. -1 is empty. */
+    struct Node {
+        std::vector<int> entries;
+        int used; //entries that are not -1
+    };
+    int NewNode();
+    void FreeNode(int node);
+    /* Index into a table at level (0 is the top) for page_number. */
+    int Index(int page_number, int level) const;
+    void CollectPages(int node, int level, int first_page, std::vector< std::pair<int, int> >& pages) const;
+    void FreeTree(int node, int level);
+
+    int levels_;
+    int bits_per_level_;
+    std::vector<Node> nodes_;
+    std::vector<int> free_nodes_;
+    size_t live_nodes_;
+    std::unordered_map<int, int> roots_; //Key is PID. Its top-level table.
+};
+
+class HashedPageTable : public PageTable {
+public:
+    /* One anchor per frame, rounded up to a power of two. */
+    explicit HashedPageTable(size_t num_frames);
+    void AddProcess(int, size_t) {}
+    void RemoveProcess(int the_PID);
+    void Map(int the_PID, int page_number, int frame);
+    void Unmap(int the_PID, int page_number);
+    void MappedPages(int the_PID, std::vector< std::pair<int, int> >& pages) const;
+    size_t OverheadBytes() const;
+    const char* Name() const { return "hashed inverted"; }
+protected:
+    int Walk(int the_PID, int page_number, unsigned& accesses) const;
+private:
+    /* A mapping. Entries hashing to the same anchor are chained through next. A free entry has PID -1. */
+    struct Entry {
+        int PID;
+        int page_number;
+        int frame;
+        int next;
+    };
+    size_t Hash(int the_PID, int page_number) const;
+
+    std::vector<int> anchors_; //First entry of each chain, or -1
+    std::vector<Entry> entries_;
+    std::vector<int> free_entries_;
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "ProcessGroups.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+ProcessGroups::ProcessGroups() : top_level_weight_(0) {
+    Add(kTopLevel, 0, 1, 0);
+}
+
+int ProcessGroups::Add(int parent, size_t max_frames, int weight, int io_per_second) {
+    Group group;
+    group.parent = parent;
+    group.max_frames = max_frames;
+    group.weight = std::max(1, weight);
+    group.io_per_second = io_per_second;
+    group.child_weight = 0;
+    group.processes = 0;
+    group.cpu_ms = 0.0;
+    group.frames = 0;
+    group.peak_frames = 0;
+    group.limit_evictions = 0;
+    group.held_jobs = 0;
+    group.io_requests = 0;
+    group.io_delayed = 0;
+    group.io_delay_ms = 0.0;
+    if (parent == kTopLevel) top_level_weight_ += group.weight;
+    else groups_[parent].child_weight += group.weight;
+    groups_.push_back(group);
+    return groups_.size() - 1;
+}
+
+bool ProcessGroups::Within(int group, int ancestor) const {
+    for (; group != kTopLevel; group = groups_[group].parent)
+        if (group == ancestor) return true;
+    return false;
+}
+
+void ProcessGroups::CountProcess(int group) {
+    for (; group != kTopLevel; group = groups_[group].parent)
+        ++groups_[group].processes;
+}
+
+size_t ProcessGroups::FrameLimit(int group) const {
+    size_t limit = 0;
+    for (; group != kTopLevel; group = groups_[group].parent) {
+        size_t max_frames = groups_[group].max_frames;
+        if ( (max_frames > 0) && ((limit == 0) || (max_frames < limit)) ) limit = max_frames;
+    }
+    return limit;
+}
+
+int ProcessGroups::FullGroup(int group) const {
+    for (; group != kTopLevel; group = groups_[group].parent)
+        if ( (groups_[group].max_frames > 0) && (groups_[group].frames >= groups_[group].max_frames) ) return group;
+    return -1;
+}
+
+bool ProcessGroups::RoomFor(int group, size_t frames) const {
+    for (; group != kTopLevel; group = groups_[group].parent)
+        if ( (groups_[group].max_frames > 0) && (groups_[group].frames + frames > groups_[group].max_frames) ) return false;
+    return true;
+}
+
+void ProcessGroups::ChargeFrames(int group, long frames) {
+    for (; group != kTopLevel; group = groups_[group].parent) {
+        Group& charged = groups_[group];
+        charged.frames += frames;
+        if (charged.frames > charged.peak_frames) charged.peak_frames = charged.frames;
+    }
+}
+
+void ProcessGroups::ChargeCPU(int group, double ms) {
+    for (; group != kTopLevel; group = groups_[group].parent)
+        groups_[group].cpu_ms += ms;
+}
+
+double ProcessGroups::Share(int group) const {
+    double share = 1.0;
+    for (; group != kTopLevel; group = groups_[group].parent) {
+        int parent = groups_[group].parent;
+        int siblings = (parent == kTopLevel) ? top_level_weight_ : groups_[parent].child_weight;
+        share *= double(groups_[group].weight) / siblings;
+    }
+    return share;
+}
+
+bool ProcessGroups::TakeIOToken(int group, int device, double now) {
+    if ( NextIOTime(group, device, now) > now ) return false;
+    for (int limited = group; limited != kTopLevel; limited = groups_[limited].parent) {
+        Group& charged = groups_[limited];
+        ++charged.io_requests;
+        if (charged.io_per_second == 0) continue;
+        IOBucket bucket = { Tokens(charged, device, now) - 1.0, now };
+        charged.buckets[device] = bucket;
+    }
+    return true;
+}
+
+double ProcessGroups::NextIOTime(int group, int device, double now) const {
+    double next = now;
+    for (; group != kTopLevel; group = groups_[group].parent) {
+        const Group& limited = groups_[group];
+        if (limited.io_per_second == 0) continue;
+        double tokens = Tokens(limited, device, now);
+        if (tokens < 1.0) next = std::max(next, now + (1.0 - tokens) * 1000.0 / limited.io_per_second);
+    }
+    return next;
+}
+
+void ProcessGroups::CountIODelay(int group, double delay_ms) {
+    ++groups_[group].io_delayed;
+    groups_[group].io_delay_ms += delay_ms;
+}
+
+double ProcessGroups::Tokens(const Group& group, int device, double now) const {
+    auto bucket = group.buckets.find(device);
+    double capacity = std::max(1, group.io_per_second);
+    if ( bucket == group.buckets.end() ) return capacity; //No request yet: the bucket is full.
+    return std::min(capacity, bucket->second.tokens + (now - bucket->second.updated) * group.io_per_second / 1000.0);
+}
+
+void ProcessGroups::Display(std::ostream& out) const {
+    double total_cpu_ms = 0.0;
+    for (size_t i = 0; i < groups_.size(); ++i)
+        if (groups_[i].parent == kTopLevel) total_cpu_ms += groups_[i].cpu_ms;
+    out << "   Process groups: " << std::dec << groups_.size() - 1 << "  CPU time: " << total_cpu_ms << " ms\n"
+        << std::setw(7) << "Group|" << std::setw(8) << "Parent|" << std::setw(7) << "Procs|" << std::setw(8)
+        << "Weight|" << std::setw(8) << "Share|" << std::setw(8) << "CPU %|" << std::setw(8) << "Frames|"
+        << std::setw(7) << "Limit|" << std::setw(6) << "Peak|" << std::setw(6) << "Held|" << std::setw(9)
+        << "Evicted|" << std::setw(7) << "I/O/s|" << std::setw(10) << "Requests|" << std::setw(9) << "Delayed|"
+        << std::setw(11) << "Avg Delay" << std::endl;
+    for (size_t i = 0; i < groups_.size(); ++i) {
+        const Group& group = groups_[i];
+        out << std::setw(6) << i << std::setw(8);
+        if (group.parent == kTopLevel) out << "--";
+        else out << group.parent;
+        out << std::setw(7) << group.processes << std::setw(8) << group.weight << std::setw(7)
+            << int(100.0 * Share(i) + 0.5) << "%" << std::setw(7)
+            << int(total_cpu_ms > 0 ? 100.0 * group.cpu_ms / total_cpu_ms + 0.5 : 0.0) << "%" << std::setw(8) << group.frames
+            << std::setw(7);
+        if (group.max_frames == 0) out << "--";
+        else out << group.max_frames;
+        out << std::setw(6) << group.peak_frames << std::setw(6) << group.held_jobs << std::setw(9)
+            << group.limit_evictions << std::setw(7);
+        if (group.io_per_second == 0) out << "--";
+        else out << group.io_per_second;
+        out << std::setw(10) << group.io_requests << std::setw(9) << group.io_delayed << std::setw(9)
+            << (group.io_delayed ? group.io_delay_ms / group.io_delayed : 0.0) << "ms" << std::endl;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Author: Emma Kimlin
+ * Title: ProcessGroups.h
+ * Date Created: 10.18.2026
+ * Description: Process groups with hierarchical resource limits, in the manner of control groups. Every process is in
+ *              one group, and groups form a tree. A group may cap the frames held by the processes under it, divides
+ *              its parent's CPU share among its siblings by its weight, and may cap the I/O requests per second made
+ *              under it to each device. A limit holds for everything under the group, so a group can never get more
+ *              than a group above it allows. Every group accounts for the CPU time, frames and I/O used under it and
+ *              for how often its limits held its processes back, so a noisy neighbor can be contained and measured.
+*/
+
+#ifndef ProcessGroups_h
+#define ProcessGroups_h
+
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <vector>
+
+class ProcessGroups {
+public:
+    static const int kDefaultGroup = 0; //Processes not placed in a group: a top-level group of weight 1 without limits
+    static const int kTopLevel = -1; //Parent of the top-level groups
+
+    ProcessGroups();
+
+    /*
+     * Adds a group under parent (kTopLevel for none). max_frames and io_per_second of 0 set no limit; weight is at
+     * least 1. Returns the number of the group.
+    */
+    int Add(int parent, size_t max_frames, int weight, int io_per_second);
+
+    size_t Size() const { return groups_.size(); }
+    /* True if groups other than kDefaultGroup were added. */
+    bool Enabled() const { return groups_.size() > 1; }
+    int Parent(int group) const { return groups_[group].parent; }
+    /* True if group is ancestor or lies under it. */
+    bool Within(int group, int ancestor) const;
+
+    /* A process was placed in group. */
+    void CountProcess(int group);
+
+    /* Frame limit of group alone; 0 if it has none. */
+    size_t MaxFrames(int group) const { return groups_[group].max_frames; }
+    /* Tightest frame limit of group and the groups above it; 0 if none has one. */
+    size_t FrameLimit(int group) const;
+    /* Frames held by the processes under group. A frame shared by several processes is held by each. */
+    size_t Frames(int group) const { return groups_[group].frames; }
+    /* Nearest group, group itself or one above it, holding all the frames its limit allows; -1 if there is none. */
+    int FullGroup(int group) const;
+    /* True if frames more frames can be held under group without passing a limit. */
+    bool RoomFor(int group, size_t frames) const;
+    /* The processes of group took (frames > 0) or gave back frames. Charged to group and every group above it. */
+    void ChargeFrames(int group, long frames);
+    /* A frame under group was replaced because group was at its frame limit. */
+    void CountLimitEviction(int group) { ++groups_[group].limit_evictions; }
+    /* A job of group waited in the Job Pool because a frame limit left no room for it. */
+    void CountHeldJob(int group) { ++groups_[group].held_jobs; }
+
+    /* A process of group ran ms in the CPU. Charged to group and every group above it. */
+    void ChargeCPU(int group, double ms);
+    /* Fraction of the CPU group is entitled to: its weight's part of its siblings' weights, of its parent's share. */
+    double Share(int group) const;
+    /* CPU time used under group per unit of share. The group furthest below its share has the smallest. */
+    double NormalizedUsage(int group) const { return groups_[group].cpu_ms / Share(group); }
+
+    /*
+     * A process of group requests I/O from device (a number telling the devices apart) at time now, in ms. Every
+     * group on the way up that limits I/O has a bucket per device holding up to a second's requests, refilled at its
+     * rate. Takes one request from each and returns true, or takes nothing and returns false if one is empty.
+    */
+    bool TakeIOToken(int group, int device, double now);
+    /* Earliest time, not before now, at which TakeIOToken() for group and device would succeed. */
+    double NextIOTime(int group, int device, double now) const;
+    /* A request of group held back by an I/O limit was released after delay_ms. */
+    void CountIODelay(int group, double delay_ms);
+
+    /* Prints every group with its limits, share and use of the CPU, frames and I/O, and what its limits held back. */
+    void Display(std::ostream& out) const;
+
+private:
+    struct IOBucket {
+        double tokens; //requests that may be made now
+        double updated; //time tokens was last refilled, in ms
+    };
+    struct Group {
+        int parent;
+        size_t max_frames; //0 if no limit
+        int weight;
+        int io_per_second; //to each device; 0 if no limit
+        int child_weight; //sum of the weights of the groups directly under this one
+        unsigned long processes;
+        double cpu_ms;
+        size_t frames;
+        size_t peak_frames;
+        unsigned long limit_evictions;
+        unsigned long held_jobs;
+        unsigned long io_requests;
+        unsigned long io_delayed;
+        double io_delay_ms;
+        std::map<int, IOBucket> buckets; //Key is device.
+    };
+
+    /* Requests in the bucket of group for device at time now. */
+    double Tokens(const Group& group, int device, double now) const;
+
+    std::vector<Group> groups_; //groups_[number]
+    int top_level_weight_; //sum of the weights of the top-level groups
+};
+
+#endif
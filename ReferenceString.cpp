@@ -0,0 +1,76 @@
+#include "ReferenceString.h"
+#include <cmath>
+
+/********************Public Member Functions********************/
+
+ReferenceString::ReferenceString() {
+    pattern_ = kNone;
+    num_pages_ = 0;
+    position_ = 0;
+    stride_ = 1;
+    phase_base_ = 0;
+    phase_pages_ = 0;
+    phase_length_ = 0;
+    phase_remaining_ = 0;
+    write_percent_ = 0;
+}
+
+ReferenceString::ReferenceString(Pattern the_pattern, int num_pages, unsigned seed, int write_percent, int stride,
+                                 int phase_pages, int phase_length) : generator_(seed == 0 ? 1 : seed) {
+    pattern_ = num_pages > 0 ? the_pattern : kNone;
+    num_pages_ = num_pages;
+    position_ = 0;
+    stride_ = stride > 0 ? stride : 1;
+    phase_pages_ = phase_pages > num_pages ? num_pages : phase_pages;
+    if (phase_pages_ <= 0) phase_pages_ = 1;
+    phase_length_ = phase_length > 0 ? phase_length : 1;
+    phase_base_ = 0;
+    phase_remaining_ = phase_length_;
+    write_percent_ = write_percent;
+}
+
+int ReferenceString::NextPage() {
+    int page = 0;
+    switch (pattern_) {
+    case kSequential:
+        page = position_;
+        position_ = (position_ + 1) % num_pages_;
+        break;
+    case kStrided:
+        page = position_;
+        position_ = (position_ + stride_) % num_pages_;
+        break;
+    case kZipf: {
+        //Continuous approximation of Zipf with exponent 1: page k is referenced with probability ~ 1/(k+1).
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(generator_);
+        page = (int)std::floor(std::exp(u * std::log(num_pages_ + 1.0))) - 1;
+        if (page >= num_pages_) page = num_pages_ - 1;
+        break;
+    }
+    case kPhased:
+        if (phase_remaining_-- == 0) { //Move to a new locality.
+            phase_base_ = std::uniform_int_distribution<int>(0, num_pages_ - phase_pages_)(generator_);
+            phase_remaining_ = phase_length_ - 1;
+        }
+        page = phase_base_ + std::uniform_int_distribution<int>(0, phase_pages_ - 1)(generator_);
+        break;
+    case kNone:
+        break;
+    }
+    return page;
+}
+
+bool ReferenceString::NextIsWrite() {
+    if (write_percent_ <= 0) return false; //Read-only streams leave the generator as it was.
+    return std::uniform_int_distribution<int>(0, 99)(generator_) < write_percent_;
+}
+
+char ReferenceString::PatternLetter(Pattern the_pattern) {
+    switch (the_pattern) {
+    case kSequential: return 's';
+    case kStrided: return 't';
+    case kZipf: return 'z';
+    case kPhased: return 'f';
+    default: return '-';
+    }
+}
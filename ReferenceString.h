@@ -0,0 +1,55 @@
+/*
+ * Author: Emma Kimlin
+ * Title: ReferenceString.h
+ * Date Created: 10.18.2026
+ * Description: ReferenceString generates the stream of page numbers a process references while it runs in the CPU.
+ *              Patterns: sequential, strided, Zipf hot set, and phase-changing working sets. Each process carries
+ *              its own generator so its stream does not depend on what other processes do.
+*/
+
+#ifndef ReferenceString_h
+#define ReferenceString_h
+
+#include <random>
+
+class ReferenceString {
+public:
+    enum Pattern { kNone, kSequential, kStrided, kZipf, kPhased };
+
+    /* A process with no reference string generates no references. */
+    ReferenceString();
+
+    /*
+     * num_pages is the number of pages of the process; every page generated is in [0, num_pages).
+     * write_percent of the references are writes. stride is used by kStrided. phase_pages and phase_length
+     * (in references) are used by kPhased.
+    */
+    ReferenceString(Pattern the_pattern, int num_pages, unsigned seed, int write_percent = 0, int stride = 3,
+                    int phase_pages = 4, int phase_length = 200);
+
+    /* Returns the next page number referenced. Pre-Condition: getPattern() != kNone. */
+    int NextPage();
+
+    /* True if the reference just generated by NextPage() is a write. */
+    bool NextIsWrite();
+
+    Pattern getPattern() const { return pattern_; }
+    int getNumPages() const { return num_pages_; }
+
+    /* One-letter name of a pattern as entered by the user: 's', 't', 'z', 'f'. */
+    static char PatternLetter(Pattern the_pattern);
+
+private:
+    Pattern pattern_;
+    int num_pages_;
+    int position_;        //next page for kSequential and kStrided
+    int stride_;
+    int phase_base_;      //first page of the current working set for kPhased
+    int phase_pages_;
+    int phase_length_;
+    int phase_remaining_; //references left before kPhased moves to a new working set
+    int write_percent_;
+    std::minstd_rand generator_;
+};
+
+#endif
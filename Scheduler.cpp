@@ -9,29 +9,78 @@
  * 5.6.2016 Added memory_unit_ and updated constructor, AddProcess() accordingly.
  * 5.7.2016 Added LoadProcess() and KillProcess(). Updated ParseCommand() to recognize K#. 
  * 5.8.2016 Updated DisplayQueues() and added DisplayPageTables(). 
+ * 10.18.2026 KillProcess() no longer dereferences an idle CPU. FindPCBAndKill_CheckReadyQ() prints before erasing.
+ * 10.18.2026 Added hot-path instrumentation probes. Snapshot() shows the counters with 'i'.
+ * 10.18.2026 Added InitAdvancedOptions(). Processes carry reference strings that GenerateReferences() runs through
+ *            memory_unit_ for every reported CPU burst. Snapshot() shows working sets with 'w'.
+ * 10.18.2026 Added BalanceLoad() and suspended_. LoadProcesses() resumes suspended processes before admitting jobs.
+ *            Snapshot() shows load control with 'l'.
+ * 10.18.2026 Added SwapOutBlockedProcesses(). DeviceInterrupt() swaps processes back in; a process that cannot be
+ *            swapped in yet waits in suspended_.
+ * 10.18.2026 Added ForkProcessInCPU(). AddNewProcess() asks which program a process runs when memory shares code
+ *            pages. Reference strings include writes. Snapshot() 'm' shows frame sharing.
+ * 10.18.2026 Snapshot() 'm' shows page table overhead and cost per translation.
+ * 10.18.2026 FillCPU() places the process on the NUMA node holding most of its frames. Snapshot() 'm' shows NUMA
+ *            locality.
+ * 10.18.2026 Added InitIOOptions() and MergeRequests(): a device interrupt can complete queued requests for the same
+ *            file with the one being served. Snapshot() shows I/O statistics with 'o'.
+ * 10.18.2026 Added the disk buffer cache (BufferCache.h), its frames reserved from memory_unit_. ProcessSyscall()
+ *            serves cached reads and all writes without queuing on disk_; DeviceInterrupt() caches blocks read.
+ * 10.18.2026 Added asynchronous I/O: SubmitAsyncIO() queues a request while the process keeps running, device
+ *            interrupts post its completion, and ReapCompletions() collects them or waits in reaping_.
+ * 10.18.2026 Added SSDs: requests go through a submission queue to one of several channels, and SSDInterrupt()
+ *            completes the front request of every channel at once. Snapshot() shows SSD channels with 'n'.
+ * 10.18.2026 Replaced printer_, disk_, CD_RW_ and the SSD members with devices_ (Device.h), indexed by device class.
+ *            ParseCommand() looks the class up by letter; one DeviceInterrupt() serves FIFO devices and SSDs alike.
+ * 10.18.2026 Added aging to the Ready Queue, measured on clock_ms_ (CPU time run), and the starvation alarm.
+ *            Snapshot() shows waits with 'a'.
+ * 10.18.2026 AddProcessToReadyQueue() preempts only when the gain exceeds the modeled context switch cost.
+ *            Snapshot() shows context switches with 'x'.
+ * 10.18.2026 Added real-time tasks, scheduled by EDF or rate-monotonic ahead of the SJF class, with a schedulability
+ *            test at admission and deadline-miss accounting. Snapshot() shows them with 't'.
+ * 10.18.2026 Added CreateThreadInCPU(). Memory is looked up by a PCB's address space; switching between threads of
+ *            one process does not pay for the TLB flush.
+ * 10.18.2026 Added files_ (FileTable.h): requests carry interned file numbers, and each file counts its open requests
+ *            and I/O. Snapshot() shows the file table with 'f'.
+ * 10.18.2026 Added process groups (ProcessGroups.h) with hierarchical limits: frames in memory_unit_, CPU share in
+ *            NextToRun(), and I/O requests per second to each device, held in throttled_io_ by SubmitToDevice().
+ *            Snapshot() shows per-group accounting with 'g'.
+ * 10.18.2026 The Scheduler reads and writes the streams it is constructed with instead of std::cin and std::cout, and
+ *            its commands return a CommandStatus, so Simulator.h can drive it as a library.
+ * 10.18.2026 Added InitMultiprocessor(): multiprocessor_ records every burst by gang and compares gang scheduling with
+ *            independent SJF on several CPUs. Snapshot() shows it with 'u'.
+ * 10.18.2026 Added InitEnergy(): energy_ (Energy.h) sets the P-state when FillCPU() places a process and the C-state
+ *            when the CPU idles, and charges bursts and device service to processes. Snapshot() shows it with 'e'.
+ * 10.18.2026 Every command has an overload that takes its arguments and the CPU time used instead of asking for them.
+ *            The questions of AddNewProcess(), UpdatePCB_InCPU() and Snapshot() only gather those arguments.
+ * 10.18.2026 The reference pattern, references per millisecond and percent of writes are asked among the advanced
+ *            memory options (Memory::InitPaging()) instead of InitAdvancedOptions().
  */
 
 #include "Scheduler.h"
 #include <iomanip>
 #include <cmath>
 #include <sstream> 
+#include <algorithm>
+#include <cctype>
 #include "Memory.h"
+#include "Instrumentation.h"
 /********************Utility Functions********************/
 namespace SchedulerNamespace {
 
 //Utility Function that returns positive integer provided by user.
-int GetPositiveIntFromUser() { 
+int GetPositiveIntFromUser(std::istream& in, std::ostream& out) { 
     std::string user_input;
     int integer_value;
     std::stringstream ss;
     bool bad_input = true;
     while (bad_input) {
-        std::cin >> user_input;
+        in >> user_input;
         ss << user_input;
         if ( (ss >> integer_value) && !(ss >> user_input) && (integer_value >= 0) ) //user entered a positive integer that is not trailed by a string
             bad_input = false;
         else {
-            std::cout << "       Invalid Input. Enter a number.";
+            out << "       Invalid Input. Enter a number.";
             ss.str("");
             ss.clear();
         }
@@ -39,264 +88,938 @@ int GetPositiveIntFromUser() {
     return integer_value;
 }
 
+//Utility Function that returns true if user answers 'y' and false if user answers 'n'.
+bool GetYesNoFromUser(std::istream& in, std::ostream& out) {
+    std::string user_input;
+    in >> user_input;
+    while ( (user_input != "y") && (user_input != "n") ) {
+        out << "       Invalid Input. Enter 'y' or 'n'.";
+        in >> user_input;
+    }
+    return user_input == "y";
+}
+
+struct SwapCandidate { //A process waiting in a device queue that the medium-term scheduler may swap out.
+    int PID;
+    size_t depth; //processes ahead of it in its device queue
+    size_t gain; //memory given back by swapping it out
+};
+
+bool LongerWait(const SwapCandidate& lhs, const SwapCandidate& rhs) {
+    return (lhs.depth != rhs.depth) ? lhs.depth > rhs.depth : lhs.gain > rhs.gain;
+}
+
+bool MoreMemory(const SwapCandidate& lhs, const SwapCandidate& rhs) { return lhs.gain > rhs.gain; }
+
+//True if word can be read back as one answer.
+bool OneWord(const std::string& word) {
+    return !word.empty() && (word.find_first_of(" \t\n\r\f\v") == std::string::npos);
+}
+
 } //end SchedulerNamespace
 
 /********************Public Member Functions********************/
-Scheduler::Scheduler() {
-    Init(printer_, "printers");
-    Init(disk_, "disks");
-    Init(CD_RW_, "CD_RW devices");
+Scheduler::Scheduler(std::istream& in, std::ostream& out) : in_(in), out_(out), usage_ms_(-1), memory_unit_(in, out) {
+    Init(kPrinter);
+    Init(kDisk);
+    Init(kCD_RW);
+    InitSSDs();
     CPU_ = nullptr;
     process_counter_ = 0;
     avg_CPU_usage_ = 0.0;
     num_terminated_processes_ = 0.0;
+    io_requests_ = 0;
+    io_completions_ = 0;
+    io_interrupts_ = 0;
+    merged_requests_ = 0;
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind) {
+        completions_by_kind_[kind] = 0;
+        interrupts_by_kind_[kind] = 0;
+        busy_us_by_kind_[kind] = 0;
+    }
+    requests_since_flush_ = 0;
+    cache_write_backs_ = 0;
+    cache_flushes_ = 0;
+    async_submitted_ = 0;
+    async_completed_ = 0;
+    async_reaped_ = 0;
+    async_waits_ = 0;
+    async_overlapped_ = 0;
+    clock_ms_ = 0.0;
+    starvation_alarms_ = 0;
+    max_wait_ms_ = 0.0;
+    total_wait_ms_ = 0.0;
+    num_waits_ = 0;
+    context_switches_ = 0;
+    thread_switches_ = 0;
+    switch_us_ = 0.0;
+    last_address_space_ = -1;
+    arrivals_while_running_ = 0;
+    preemptions_ = 0;
+    preemptions_not_worth_cost_ = 0;
+    jobs_completed_ = 0;
+    deadline_misses_ = 0;
+    io_limit_idle_ms_ = 0.0;
+    for (int i = 0; i < kLatenessBuckets; ++i)
+        lateness_histogram_[i] = 0;
     InitHisParam();
     InitBurst();
     InitNumCylinders();
-    std::cout << "System Generation completed. Begin entering commands.\n";
+    InitIOOptions();
+    InitAdvancedOptions();
+    out_ << "System Generation completed. Begin entering commands.\n";
 }
 
-void Scheduler::AddNewProcess()
+Scheduler::~Scheduler() {
+    delete CPU_;
+}
+
+CommandStatus Scheduler::AddNewProcess()
 {
-    std::cout << "     What is the size of this process? ";
-    size_t size_of_process = SchedulerNamespace::GetPositiveIntFromUser();
-    if (size_of_process > memory_unit_.GetTotalMemorySize()) {
-        std::cout << "       Size of Process cannot be larger than total memory. Rejected. \n";
-        return;
+    ProcessSpec spec = ProcessSpec();
+    out_ << "     What is the size of this process? ";
+    spec.size = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    if (spec.size > memory_unit_.GetTotalMemorySize()) return CreateProcess(spec); //Rejected before anything else is asked.
+    if ( memory_unit_.CodeSharingEnabled() ) {
+        out_ << "     Which program is this process running? ";
+        in_ >> spec.program;
     }
-    PCB p(++process_counter_, initial_burst_estimate_, size_of_process); //Create a new process
+    if ( groups_.Enabled() ) {
+        out_ << "     Which process group is this process in (0 for none)? ";
+        spec.group = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while ( (size_t)spec.group >= groups_.Size() ) {
+            out_ << "       Invalid Entry. Enter a group from 0 to " << groups_.Size() - 1 << ".";
+            spec.group = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+    }
+    if (real_time_policy_ != 'n') {
+        out_ << "     Enter the period of this task in milliseconds (0 if it is not a real-time task). ";
+        spec.period = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    if (spec.period > 0) {
+        out_ << "     Enter the CPU time each job of this task needs, in milliseconds. ";
+        spec.budget = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while ( (spec.budget == 0) || (spec.budget > spec.period) ) {
+            out_ << "       Invalid Entry. Enter a time from 1 to the period.";
+            spec.budget = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+        out_ << "     Enter the deadline of each job after its release, in milliseconds (0 for the period). ";
+        spec.deadline = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while ( (spec.deadline != 0) && ((spec.deadline < spec.budget) || (spec.deadline > spec.period)) ) {
+            out_ << "       Invalid Entry. Enter a time from the CPU time to the period, or 0.";
+            spec.deadline = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+    }
+    return CreateProcess(spec);
+}
+
+CommandStatus Scheduler::CreateProcess(const ProcessSpec& spec) {
+    if (spec.size > memory_unit_.GetTotalMemorySize()) {
+        out_ << "       Size of Process cannot be larger than total memory. Rejected. \n";
+        return kRejected;
+    }
+    PCB p(++process_counter_, initial_burst_estimate_, spec.size); //Create a new process
+    if ( memory_unit_.CodeSharingEnabled() ) p.setProgram( memory_unit_.ProgramID(spec.program) );
+    if ( groups_.Enabled() ) {
+        p.setGroup(spec.group);
+        if ( memory_unit_.ExceedsGroupLimit(p) ) {
+            out_ << "       Process needs more frames than its group may hold. Rejected. \n";
+            return kRejected;
+        }
+    }
+    if ( (spec.period > 0) && !AdmitRealTime(p, spec.period, spec.budget, spec.deadline) ) return kRejected;
+    groups_.CountProcess( p.getGroup() );
+    AssignReferenceString(p);
     bool process_assigned_memory = memory_unit_.AssignMemory(p); //Place process in Job Pool or assign it memory depending on available memory
     if (process_assigned_memory) AddProcessToReadyQueue(p); //If process was assigned memory, give it to Ready Queue
+    ReleaseThrottledIO();
+    BalanceLoad();
+    SwapOutBlockedProcesses();
+    return process_assigned_memory ? kDone : kInJobPool;
 }
 
-void Scheduler::TerminateProcessInCPU() {
-    if (CPU_ == nullptr) //Handle user error
-        std::cout << "       There is no process to terminate in the CPU. Please enter another command.\n";
-    else {
-        std::cout << "     Process " << CPU_->getPID() << " has finished running in the CPU. \n";
+CommandStatus Scheduler::ForkProcessInCPU() {
+    if (CPU_ == nullptr) { //Handle user error
+        out_ << "       There is no process in the CPU to fork. Please enter another command.\n";
+        return kNoProcessInCPU;
+    }
+    PCB child(++process_counter_, initial_burst_estimate_, CPU_->getSizeOfProcess());
+    child.setProgram( CPU_->getProgram() );
+    child.setGroup( CPU_->getGroup() );
+    groups_.CountProcess( child.getGroup() );
+    AssignReferenceString(child);
+    out_ << "     Process " << CPU_->getPID() << " has forked P" << child.getPID() << ". \n";
+    if ( memory_unit_.ForkProcess(CPU_->getAddressSpace(), child) ) 
+        AddProcessToReadyQueue(child);
+    else if ( memory_unit_.AssignMemory(child) ) //Parent is not in memory: the child is admitted like a new process.
+        AddProcessToReadyQueue(child);
+    ReleaseThrottledIO();
+    BalanceLoad();
+    SwapOutBlockedProcesses();
+    return kDone;
+}
+
+CommandStatus Scheduler::CreateThreadInCPU() {
+    if (CPU_ == nullptr) { //Handle user error
+        out_ << "       There is no process in the CPU to create a thread. Please enter another command.\n";
+        return kNoProcessInCPU;
+    }
+    PCB thread(++process_counter_, initial_burst_estimate_, CPU_->getSizeOfProcess());
+    thread.setAddressSpace( CPU_->getAddressSpace() );
+    thread.setProgram( CPU_->getProgram() );
+    thread.setGroup( CPU_->getGroup() );
+    groups_.CountProcess( thread.getGroup() );
+    AssignReferenceString(thread);
+    int& num_threads = num_threads_[ CPU_->getAddressSpace() ];
+    num_threads = (num_threads == 0) ? 2 : num_threads + 1;
+    out_ << "     Process " << CPU_->getAddressSpace() << " has created thread P" << thread.getPID() << ". It has "
+         << num_threads << " threads.\n";
+    AddProcessToReadyQueue(thread);
+    return kDone;
+}
+
+CommandStatus Scheduler::TerminateProcessInCPU() {
+    if (CPU_ == nullptr) { //Handle user error
+        out_ << "       There is no process to terminate in the CPU. Please enter another command.\n";
+        return kNoProcessInCPU;
+    } else {
+        out_ << "     Process " << CPU_->getPID() << " has finished running in the CPU. \n";
+        CancelAsyncIO( CPU_->getPID() );
         UpdateAccountingInfo_Syscall(*CPU_);
         TerminatingProcessAccounting(*CPU_);
         delete CPU_; //Delete the process in the CPU
         CPU_ = nullptr;
         FillCPU(); //Fill the CPU with the next process in the Ready Queue. 
         LoadProcesses(); //Now that there is more available memory, give memory to next process in Job Pool. 
+        ReleaseThrottledIO();
+        return kDone;
     }
 }
 
 void Scheduler::Snapshot() {
     std::string user_input;
-    std::cout << "  A Snapshot interrupt has been issued. \n"
-              << "     The average CPU time of completed processes is: " << avg_CPU_usage_ << " ms.\n" 
-              << "     Enter 'r', 'p', 'c','d', 'm' or 'j'" << std::endl;
-    std::cin >> user_input;
-    if (user_input == "r")
+    out_ << "  A Snapshot interrupt has been issued. \n"
+         << "     The average CPU time of completed processes is: " << avg_CPU_usage_ << " ms.\n" 
+         << "     Enter 'r', 'p', 'c','d', 'n', 'm', 'j', 'w', 'l', 'o', 'a', 'x', 't', 'f', 'g', 'u', 'e' or 'i'" << std::endl;
+    in_ >> user_input;
+    Snapshot(user_input.size() == 1 ? user_input[0] : ' ');
+}
+
+void Scheduler::Snapshot(char view) {
+    if (view == 'r')
         DisplayReadyQueue();
-    else if ( (user_input == "p") || (user_input == "c") || (user_input == "d") ) {
+    else if ( (Device::KindOfLetter(view) != kNumDeviceKinds) && std::islower(view) ) {
         DisplayHeader();
-        if (user_input == "p")
-            DisplayQueues(printer_, 'p');
-        else if (user_input == "c")
-            DisplayQueues(CD_RW_, 'c');
-        else if (user_input == "d") 
-            DisplayQueues(disk_, 'd');
-    } else if (user_input == "m") {
+        DisplayQueues( Device::KindOfLetter(view) );
+    } else if (view == 'm') {
             memory_unit_.DisplayFreeFrameList();
             memory_unit_.DisplayFrameList();
-    } else if (user_input == "j")
+            memory_unit_.DisplaySharing();
+            memory_unit_.DisplayTranslation();
+            memory_unit_.DisplayNUMA();
+    } else if (view == 'j')
             memory_unit_.DisplayJobPool(); 
+    else if (view == 'w')
+            memory_unit_.DisplayWorkingSets();
+    else if (view == 'l')
+            DisplayLoadControl();
+    else if (view == 'o')
+            DisplayIOStats();
+    else if (view == 'a')
+            DisplayAging();
+    else if (view == 'x')
+            DisplayContextSwitches();
+    else if (view == 't')
+            DisplayRealTime();
+    else if (view == 'f')
+            files_.Display(out_);
+    else if (view == 'g')
+            DisplayGroups();
+    else if (view == 'u') {
+        if (multiprocessor_) multiprocessor_->Display(out_);
+        else out_ << "   Multiprocessor model: none.\n";
+    } else if (view == 'e') {
+        if (energy_) energy_->Display(out_);
+        else out_ << "   Energy model: none.\n";
+    } else if (view == 'i')
+            Instrumentation::Report(out_);
     else
-        std::cout << "       Bad input. Type 'S' and hit Enter to issue another Snapshot interrupt.\n";
+        out_ << "       Bad input. Type 'S' and hit Enter to issue another Snapshot interrupt.\n";
 }
 
-void Scheduler::ParseCommand (std::string user_input) {
+CommandStatus Scheduler::ParseCommand (std::string user_input) {
     char first_letter = user_input.front();
-    std::string device_number = user_input.substr(1, user_input.size() -1);
+    bool async_io = (first_letter == 'a') && (user_input.size() > 1); //Asynchronous request: "a" followed by a system call
+    if (async_io) first_letter = user_input[1];
+    std::string device_number = user_input.substr(async_io ? 2 : 1);
     std::istringstream ss(device_number);
     int num_entered;
     if ( (ss >> num_entered) && !(ss >> user_input) ) {
-        if ((first_letter == 'p') && ((unsigned)num_entered <= printer_.size()))
-            ProcessSyscall(printer_[num_entered-1], "printer", num_entered);
-        else if ((first_letter == 'P') && ((unsigned)num_entered <= printer_.size()))
-            DeviceInterrupt(printer_[num_entered-1], "printer");
-        else if ((first_letter == 'c') && ((unsigned)num_entered <= CD_RW_.size()))
-            ProcessSyscall(CD_RW_[num_entered-1], "CD_RW", num_entered);
-        else if ((first_letter == 'C') && ((unsigned)num_entered <= CD_RW_.size()))
-            DeviceInterrupt(CD_RW_[num_entered-1], "CD_RW");
-        else if ((first_letter == 'd') &&  ((unsigned)num_entered <= disk_.size()))
-            ProcessSyscall(disk_[num_entered-1], "disk", num_entered);
-        else if ((first_letter == 'D') && ((unsigned)num_entered <= disk_.size()))
-            DeviceInterrupt(disk_[num_entered-1], "disk");
-        else if ( (first_letter == 'K') && (num_entered > 0) && (num_entered <= process_counter_) )
-            KillProcess(num_entered);  
-        else //User entered correct format, but did not reference a device in system.
-            std::cout << "       Invalid Commmand. This system has " << printer_.size() << " printers, "
-            <<"     " << CD_RW_.size() << " CD/RW, and " << disk_.size() << " disks. Please try again.";
+        DeviceKind kind = Device::KindOfLetter(first_letter);
+        bool is_syscall = std::islower(first_letter);
+        if ( HasDevice(kind, num_entered) && (is_syscall || !async_io) ) {
+            Device& device = *devices_[kind][num_entered-1];
+            if (async_io) return SubmitAsyncIO(device);
+            else if (is_syscall) return ProcessSyscall(device);
+            else return DeviceInterrupt(device);
+        }
+        else if ( !async_io && (first_letter == 'K') && (num_entered > 0) && (num_entered <= process_counter_) )
+            return KillProcess(num_entered);  
+        else { //User entered correct format, but did not reference a device in system.
+            out_ << "       Invalid Commmand. This system has ";
+            for (int k = 0; k < kNumDeviceKinds; ++k)
+                out_ << devices_[k].size() << " " << Device::Classes(DeviceKind(k)).plural
+                     << (k + 2 < kNumDeviceKinds ? ", " : (k + 1 < kNumDeviceKinds ? ", and " : ". "));
+            out_ << "Please try again.";
+        }
     } else //User did not use correct format
-            std::cout << "       Invalid Commmand. Please enter one character specificying device, followed"
-                      << "       by one number. \n";
+            out_ << "       Invalid Commmand. Please enter one character specificying device, followed"
+                 << "       by one number. \n";
+    return kBadCommand;
+}
+
+CommandStatus Scheduler::AddNewProcess(const ProcessSpec& spec, int usage_ms) {
+    if ( memory_unit_.CodeSharingEnabled() && !SchedulerNamespace::OneWord(spec.program) ) return kBadCommand;
+    if ( (spec.group < 0) || ((size_t)spec.group >= groups_.Size()) ) return kBadCommand;
+    if (spec.period < 0) return kBadCommand;
+    if (spec.period > 0) {
+        if (real_time_policy_ == 'n') return kBadCommand; //No real-time policy to schedule it by.
+        if ( (spec.budget < 1) || (spec.budget > spec.period) ) return kBadCommand;
+        if ( (spec.deadline != 0) && ((spec.deadline < spec.budget) || (spec.deadline > spec.period)) )
+            return kBadCommand;
+    }
+    return WithUsage(usage_ms, [&]() { return CreateProcess(spec); });
+}
+
+CommandStatus Scheduler::TerminateProcessInCPU(int usage_ms) {
+    return WithUsage(usage_ms, [&]() { return TerminateProcessInCPU(); });
+}
+
+CommandStatus Scheduler::ForkProcessInCPU(int usage_ms) {
+    return WithUsage(usage_ms, [&]() { return ForkProcessInCPU(); });
+}
+
+CommandStatus Scheduler::CreateThreadInCPU(int usage_ms) {
+    return WithUsage(usage_ms, [&]() { return CreateThreadInCPU(); });
+}
+
+CommandStatus Scheduler::Syscall(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms) {
+    if ( !HasDevice(kind, number) ) return kBadCommand;
+    Device& device = *devices_[kind][number-1];
+    if ( (CPU_ != nullptr) && !ValidRequest(device, request) ) return kBadCommand;
+    return WithUsage(usage_ms, [&]() { return ProcessSyscall(device, &request); });
+}
+
+CommandStatus Scheduler::SubmitAsync(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms) {
+    if ( !HasDevice(kind, number) ) return kBadCommand;
+    Device& device = *devices_[kind][number-1];
+    if ( (CPU_ != nullptr) && !ValidRequest(device, request) ) return kBadCommand;
+    return WithUsage(usage_ms, [&]() { return SubmitAsyncIO(device, &request); });
+}
+
+CommandStatus Scheduler::Interrupt(DeviceKind kind, int number, int usage_ms) {
+    if ( !HasDevice(kind, number) ) return kBadCommand;
+    return WithUsage(usage_ms, [&]() { return DeviceInterrupt(*devices_[kind][number-1]); });
+}
+
+CommandStatus Scheduler::Kill(int PID, int usage_ms) {
+    if ( (PID < 1) || (PID > process_counter_) ) return kNoSuchProcess;
+    return WithUsage(usage_ms, [&]() { return KillProcess(PID); });
+}
+
+CommandStatus Scheduler::ReapCompletions(int usage_ms) {
+    return WithUsage(usage_ms, [&]() { return ReapCompletions(); });
 }
 
 /********************Private Member Functions********************/
-void Scheduler::Init(std::vector<std::deque<PCB> >& device, std::string device_name) {
-    std::cout << "   Enter the number of " << device_name << " that are in this system and press Enter." << std::endl;
-    int num_device = SchedulerNamespace::GetPositiveIntFromUser();
+
+CommandStatus Scheduler::WithUsage(int usage_ms, const std::function<CommandStatus()>& command) {
+    if (usage_ms < 0) return kBadCommand;
+    usage_ms_ = usage_ms;
+    CommandStatus status = command();
+    usage_ms_ = -1;
+    return status;
+}
+
+int Scheduler::BurstUsage() {
+    if (usage_ms_ >= 0) return usage_ms_;
+    out_ << "     How long did this process use the CPU (ms)? ";
+    return SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+}
+
+void Scheduler::Init(DeviceKind kind) {
+    out_ << "   Enter the number of " << Device::Classes(kind).plural << " that are in this system and press Enter." << std::endl;
+    int num_device = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
     for (int i = 0; i < num_device; ++i)
-        device.push_back(std::deque<PCB>()); //Create queue for each device to be able to hold its processes
+        devices_[kind].push_back( std::unique_ptr<Device>(Device::CreateFIFO(kind, i+1)) ); //Each device has a queue to hold its processes
+}
+
+void Scheduler::InitSSDs() {
+    out_ << "   Enter the number of SSDs that are in this system and press Enter." << std::endl;
+    int num_SSDs = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    for (int i = 0; i < num_SSDs; ++i) {
+        out_ << "   Enter the number of channels for SSD " << i+1 << ". ";
+        int num_channels = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while (num_channels <= 0) {
+            out_ << "       Invalid Entry. An SSD has at least one channel.";
+            num_channels = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+        out_ << "   Enter the time a channel of SSD " << i+1 << " takes to serve a request, in microseconds. ";
+        int service_time_us = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        devices_[kSSD].push_back( std::unique_ptr<Device>(Device::CreateChannels(kSSD, i+1, num_channels, service_time_us)) );
+    }
 }
 
 void Scheduler::InitHisParam() {
     bool bad_input = true; 
     std::string user_input; 
-    std::cout << "   Enter the historical parameter for this system. ";
+    out_ << "   Enter the historical parameter for this system. ";
     while (bad_input) {
-        std::cin >> user_input;
+        in_ >> user_input;
         std::istringstream ss_his_param(user_input);
         if ((ss_his_param >> history_parameter_) && (history_parameter_ >= 0 ) && (history_parameter_ <= 1) 
                                                  && !(ss_his_param >> user_input))
             return;
         else     
-            std::cout << "       Invalid entry. Please enter a number between 0 and 1 (inclusive). ";
+            out_ << "       Invalid entry. Please enter a number between 0 and 1 (inclusive). ";
     }
 }
 
 void Scheduler::InitBurst() {
-    std::cout << "   Enter the ititial burst estimate in milliseconds for all new processes. ";
-    initial_burst_estimate_ = SchedulerNamespace::GetPositiveIntFromUser();
+    out_ << "   Enter the ititial burst estimate in milliseconds for all new processes. ";
+    initial_burst_estimate_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
 }
 
 void Scheduler::InitNumCylinders() {
-    if ( disk_.size() == 0 ) return; 
     int num_cylinders;
-    for ( uint i = 0; i < disk_.size() ; ++i ) {
-        std::cout << "   Enter the number of cylinders for disk " << i+1 << ". "; 
-        num_cylinders = SchedulerNamespace::GetPositiveIntFromUser();
+    for ( uint i = 0; i < devices_[kDisk].size() ; ++i ) {
+        out_ << "   Enter the number of cylinders for disk " << i+1 << ". "; 
+        num_cylinders = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
         while (num_cylinders <= 0) {
-            std::cout <<"       Invalid Entry. Cannot have negative number of cylinders. Try again.";
-            num_cylinders = SchedulerNamespace::GetPositiveIntFromUser();
+            out_ <<"       Invalid Entry. Cannot have negative number of cylinders. Try again.";
+            num_cylinders = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+        devices_[kDisk][i]->setNumCylinders(num_cylinders); 
+    }
+}
+void Scheduler::InitIOOptions() {
+    io_batch_size_ = 1;
+    merge_window_ = 0;
+    async_queue_depth_ = 0;
+    flush_interval_ = 0;
+    out_ << "   Configure advanced I/O options? (y/n) ";
+    if ( !SchedulerNamespace::GetYesNoFromUser(in_, out_) ) return;
+    out_ << "     Enter the most requests a device completes with one interrupt (1 for no merging). ";
+    io_batch_size_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    while (io_batch_size_ == 0) {
+        out_ << "       Invalid Entry. A device completes at least one request.";
+        io_batch_size_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    if (io_batch_size_ > 1) {
+        out_ << "     Enter how many queued requests a device looks through for ones to merge. ";
+        merge_window_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    out_ << "     Enter the most asynchronous requests a process can have in flight (0 for synchronous I/O only). ";
+    async_queue_depth_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    out_ << "     Enter the number of frames of memory for the disk buffer cache (0 for no cache). ";
+    size_t cache_frames = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    while (cache_frames > memory_unit_.ReservableFrames()) {
+        out_ << "       Invalid Entry. The largest process must still fit: enter at most "
+             << memory_unit_.ReservableFrames() << ".";
+        cache_frames = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    if (cache_frames == 0) return;
+    std::string user_input;
+    out_ << "     Enter the buffer cache policy: 'l' LRU, '2' 2Q or 'a' ARC. ";
+    in_ >> user_input;
+    while ( (user_input != "l") && (user_input != "2") && (user_input != "a") ) {
+        out_ << "       Invalid Entry. Enter 'l', '2' or 'a'. ";
+        in_ >> user_input;
+    }
+    out_ << "     Enter how many disk requests pass between flushes of dirty blocks (0 to write back only on eviction). ";
+    flush_interval_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    memory_unit_.ReserveFrames(cache_frames); //One block per frame.
+    buffer_cache_.reset( BufferCache::Create(user_input[0], cache_frames) );
+}
+
+void Scheduler::InitAdvancedOptions() {
+    aging_rate_ = 0.0;
+    starvation_ms_ = 0;
+    context_switch_us_ = 0;
+    address_space_switch_us_ = 0;
+    real_time_policy_ = 'n';
+    gang_by_ = 't';
+    out_ << "   Configure advanced scheduling options? (y/n) ";
+    if ( !SchedulerNamespace::GetYesNoFromUser(in_, out_) ) return;
+    out_ << "     Enter the aging rate: percent of a millisecond of expected burst a process in the Ready Queue is\n"
+         << "     credited per millisecond it waits (0 for no aging). ";
+    aging_rate_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_) / 100.0;
+    out_ << "     Enter the wait in the Ready Queue, in milliseconds, that raises the starvation alarm (0 for none). ";
+    starvation_ms_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    out_ << "     Enter the cost of a context switch in microseconds: saving registers, flushing the TLB and warming\n"
+         << "     the caches (0 to preempt for any arrival that is not longer). ";
+    context_switch_us_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    if (context_switch_us_ > 0) {
+        out_ << "     Enter how much of it is flushing the TLB, which a switch between threads of the same process\n"
+             << "     does not need, in microseconds. ";
+        address_space_switch_us_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while (address_space_switch_us_ > context_switch_us_) {
+            out_ << "       Invalid Entry. Enter at most the cost of a context switch.";
+            address_space_switch_us_ = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+    }
+    std::string user_input;
+    out_ << "     Enter the real-time scheduling policy: 'e' earliest deadline first, 'r' rate-monotonic or\n"
+         << "     'n' no real-time tasks. ";
+    in_ >> user_input;
+    while ( (user_input != "e") && (user_input != "r") && (user_input != "n") ) {
+        out_ << "       Invalid Entry. Enter 'e', 'r' or 'n'. ";
+        in_ >> user_input;
+    }
+    real_time_policy_ = user_input[0];
+    InitGroups();
+    InitMultiprocessor();
+    InitEnergy();
+}
+
+void Scheduler::InitGroups() {
+    out_ << "     Enter the number of process groups (0 for none). ";
+    int num_groups = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    for (int i = 1; i <= num_groups; ++i) {
+        out_ << "     Enter the group that group " << i << " is under (0 for none). ";
+        int parent = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while (parent >= i) {
+            out_ << "       Invalid Entry. Enter 0 or a group numbered before this one.";
+            parent = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        }
+        out_ << "     Enter the most frames the processes of group " << i << " may hold (0 for no limit). ";
+        size_t max_frames = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        out_ << "     Enter the CPU share weight of group " << i << ". ";
+        int weight = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        while (weight == 0) {
+            out_ << "       Invalid Entry. A group has a weight of at least 1.";
+            weight = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
         }
-        num_cylinders_per_disk_.push_back(num_cylinders); 
+        out_ << "     Enter the most I/O requests per second group " << i << " may make to each device (0 for no limit). ";
+        int io_per_second = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+        groups_.Add( (parent == 0) ? ProcessGroups::kTopLevel : parent, max_frames, weight, io_per_second );
     }
+    if (num_groups > 0) memory_unit_.SetGroups(&groups_);
 }
+
+void Scheduler::InitMultiprocessor() {
+    out_ << "     Enter the number of CPUs to model gang scheduling on (1 for none). ";
+    int num_CPUs = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    while (num_CPUs == 0) {
+        out_ << "       Invalid Entry. There is at least 1 CPU.";
+        num_CPUs = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    if (num_CPUs == 1) return;
+    std::string user_input;
+    out_ << "     Enter what forms a gang: 't' the threads of a process or 'g' a process group. ";
+    in_ >> user_input;
+    while ( (user_input != "t") && (user_input != "g") ) {
+        out_ << "       Invalid Entry. Enter 't' or 'g'. ";
+        in_ >> user_input;
+    }
+    gang_by_ = user_input[0];
+    multiprocessor_.reset( new Multiprocessor(num_CPUs) );
+}
+
+void Scheduler::InitEnergy() {
+    std::string user_input;
+    out_ << "     Enter the CPU frequency governor of the energy model: 'p' performance, 's' powersave, 'o' ondemand,\n"
+         << "     'e' energy-aware or 'n' no energy model. ";
+    in_ >> user_input;
+    while ( (user_input.size() != 1) || (std::string("psoen").find(user_input[0]) == std::string::npos) ) {
+        out_ << "       Invalid Entry. Enter 'p', 's', 'o', 'e' or 'n'. ";
+        in_ >> user_input;
+    }
+    if (user_input == "n") return;
+    int max_slowdown_percent = 0;
+    if (user_input == "e") {
+        out_ << "     Enter the most the governor may slow a burst down to save energy, in percent. ";
+        max_slowdown_percent = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    }
+    energy_.reset( new EnergyModel(user_input[0], max_slowdown_percent) );
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind)
+        for (size_t i = 0; i < devices_[kind].size(); ++i) {
+            const Device& device = *devices_[kind][i];
+            energy_->AddDevice(DeviceID(device), device.Kind(), device.Number(), device.ServiceTimeUs());
+        }
+}
+
 void Scheduler::FillCPU() {
+    INSTRUMENT_PROBE(kFillCPU);
     if (CPU_ != nullptr) return; //CPU is not idle; cannot add process to CPU that in use.
     if (Ready_Queue_.empty()) { //CPU is empty, but there are no process waiting to be run. 
         CPU_ = nullptr;
-        std::cout << "     No processes to run. The CPU is idle." << std::endl;
+        out_ << "     No processes to run. The CPU is idle." << std::endl;
+        if (energy_) energy_->EnterIdle();
     } else {
-        PCB process_to_run = *Ready_Queue_.begin(); //Pick next process from Ready Queue
-        std::cout << "     Process " << process_to_run.getPID() << " has been added to the CPU." << std::endl;
+        PCB process_to_run = LeaveReadyQueue( NextToRun() ); //Pick next process from Ready Queue and delete it there
+        out_ << "     Process " << process_to_run.getPID() << " has been added to the CPU";
+        if (memory_unit_.NumNodes() > 1) out_ << " on node " << memory_unit_.PlaceProcess(process_to_run.getAddressSpace());
+        out_ << "." << std::endl;
         CPU_ = new PCB(process_to_run); //copy next process in Ready Queue over to CPU
-        Ready_Queue_.erase(Ready_Queue_.begin()); //delete that process in the Ready Queue
+        if (energy_) energy_->Dispatch( process_to_run.getExpectedNextBurstRemaining(), process_to_run.IsRealTime() );
+        ++context_switches_;
+        switch_us_ += context_switch_us_;
+        if (process_to_run.getAddressSpace() == last_address_space_) { //Same page table: the TLB is not flushed.
+            ++thread_switches_;
+            switch_us_ -= address_space_switch_us_;
+        }
+        last_address_space_ = process_to_run.getAddressSpace();
     }
 }
 
-void Scheduler::DisplayQueues(std::vector<std::deque<PCB> >& device, char first_letter) const {
-    for (size_t i = 0; i < device.size(); i++) { //For each device of a certain type
-        std::cout << "   Device: " << first_letter << i+1 << std::endl; //output the device number
-        if (device[i].empty()) {
-            std::cout << "     This queue is empty.\n";
-            continue;
-        } else { //Output the processes waiting to be run by this device
-            for (auto iter = begin(device[i]); iter != end(device[i]); ++iter) {
-                iter->Print();
-                int phys_add = memory_unit_.CalculatePhysicalAddress(iter->getLogicalStartAddress(), iter->getPID());
-                std::cout << "   " << std::hex << phys_add << std::endl; //Output the physical address of this processes
+void Scheduler::DisplayQueues(DeviceKind kind) {
+    for (size_t i = 0; i < devices_[kind].size(); i++) { //For each device of a certain type
+        Device& device = *devices_[kind][i];
+        std::string label = std::string(1, device.Class().letter) + std::to_string(device.Number());
+        out_ << "   Device: " << label; //output the device number
+        if (device.Queues().size() > 1)
+            out_ << " (" << device.Queues().size() << " channels, " << std::dec << device.ServiceTimeUs() << " us per request)";
+        out_ << std::endl;
+        for (size_t k = 0; k < device.Queues().size(); ++k) {
+            std::deque<PCB>& device_queue = device.Queues()[k];
+            if (device.Queues().size() > 1) out_ << "   Channel " << k+1 << std::endl;
+            if (device_queue.empty()) {
+                out_ << "     This queue is empty.\n";
+                continue;
+            } else { //Output the processes waiting to be run by this device
+                for (auto iter = begin(device_queue); iter != end(device_queue); ++iter) {
+                    iter->Print(out_, files_);
+                    int phys_add = memory_unit_.CalculatePhysicalAddress(iter->getLogicalStartAddress(), iter->getAddressSpace());
+                    if (phys_add == -1) out_ << "   --" << std::endl; //Page is not in memory
+                    else out_ << "   " << std::hex << phys_add << std::endl; //Output the physical address of this processes
+                }
+                DisplayPageTables(device_queue, device.Queues().size() > 1 ? label + " channel " + std::to_string(k+1) : label); //Display the page table of this process
             }
-            DisplayPageTables(device, first_letter, i); //Display the page table of this process
         }
     }
 }
 
 void Scheduler::DisplayReadyQueue() const {
     if (Ready_Queue_.empty()) {
-        std::cout << "     The Ready Queue is empty.\n";
+        out_ << "     The Ready Queue is empty.\n";
     }
     else {
-        std::cout << "PID|" << std::setw(9) << "CPU Use|" << std::setw(11) << "Avg Burst|" << std::setw(7) << "Size|" 
-                  << std::setw(10) << "Log. Add|" << std::setw(10) << "Phys. Add" << std::endl; //Header
+        out_ << "PID|" << std::setw(9) << "CPU Use|" << std::setw(11) << "Avg Burst|" << std::setw(7) << "Size|" 
+             << std::setw(10) << "Log. Add|" << std::setw(10) << "Phys. Add" << std::endl; //Header
         for (auto iter = begin(Ready_Queue_); iter != end(Ready_Queue_); ++iter) {
-            std::cout << iter->getPID() << std::setw(9) << iter->getCPU_Usage() << std::setw(11) << iter->getAvgBurst() << std::setw(7) 
-                      << iter->getSizeOfProcess() << std::setw(10) << iter->getLogicalStartAddress(); 
-            std::cout << "   " << memory_unit_.CalculatePhysicalAddress(iter->getLogicalStartAddress(), iter->getPID()) << std::endl;
+            out_ << iter->getPID() << std::setw(9) << iter->getCPU_Usage() << std::setw(11) << iter->getAvgBurst() << std::setw(7) 
+                 << iter->getSizeOfProcess() << std::setw(10) << iter->getLogicalStartAddress(); 
+            int phys_add = memory_unit_.CalculatePhysicalAddress(iter->getLogicalStartAddress(), iter->getAddressSpace());
+            if (phys_add == -1) out_ << "   --" << std::endl; //Page is not in memory
+            else out_ << "   " << phys_add << std::endl;
         }
         DisplayPageTablesReadyQueue(); 
-        std::cout << std::endl;
+        out_ << std::endl;
     }
 }
 
-void Scheduler::DisplayPageTables(std::vector<std::deque<PCB> >& device, char first_letter, int which_device) const {
-    std::cout << "   Page Tables for  " << first_letter << which_device << ": \n";
-    for (auto iter = begin(device[which_device]); iter != end(device[which_device]); ++iter) 
-        memory_unit_.DisplayPageTable( iter->getPID() );
-    std::cout << "*****************\n";
+void Scheduler::DisplayPageTables(const std::deque<PCB>& device_queue, const std::string& label) const {
+    out_ << "   Page Tables for  " << label << ": \n";
+    for (auto iter = begin(device_queue); iter != end(device_queue); ++iter) 
+        memory_unit_.DisplayPageTable( iter->getAddressSpace() );
+    out_ << "*****************\n";
 }
 
 void Scheduler::DisplayPageTablesReadyQueue() const {
-    std::cout <<"   Page Tables for Processes in Ready Queue: \n";
+    out_ <<"   Page Tables for Processes in Ready Queue: \n";
     for (auto iter = Ready_Queue_.begin(); iter != Ready_Queue_.end(); ++iter)
-        memory_unit_.DisplayPageTable( iter->getPID());
-    std::cout << "*****************\n";
+        memory_unit_.DisplayPageTable( iter->getAddressSpace() );
+    out_ << "*****************\n";
 }
 
 void Scheduler::DisplayHeader() const {
-    std::cout << "PID|" << std::setw(10) << "Filename|" << std::setw(7) << "Len.|" << std::setw(5) << "R/W|" << std::setw(9) << "CPU Use|" 
+    out_ << "PID|" << std::setw(10) << "Filename|" << std::setw(7) << "Len.|" << std::setw(5) << "R/W|" << std::setw(9) << "CPU Use|" 
     << std::setw(11) << "Avg Burst|" << std::setw(10) << "Cylinder|" << std::setw(6) << "Size|" << std::setw(5) << "Log|" << std::setw(6) 
     << "Phys|" << std::endl;
 }
 
-void Scheduler::ProcessSyscall(std::deque<PCB>& device_queue, std::string device_name, int device_num) {
+CommandStatus Scheduler::ProcessSyscall(Device& device, const IORequestSpec* spec) {
+    INSTRUMENT_PROBE(kProcessSyscall);
     if (CPU_ == nullptr) {
-        std::cout << "       The CPU is idle. Please add a task to the Ready Queue before requesting I/O\n";
-        return;
+        out_ << "       The CPU is idle. Please add a task to the Ready Queue before requesting I/O\n";
+        return kNoProcessInCPU;
+    }
+    out_ << "   The process in the CPU has requested " << device.Class().name << " I/O.\n";
+    UpdatePCB_InCPU(device, spec);
+    UpdateAccountingInfo_Syscall(*CPU_);
+    ++io_requests_;
+    if ( device.Class().cached && ServedFromCache(device) ) {
+        CPU_->setCylinder(-1);
+        PCB pcb = *CPU_;
+        delete CPU_;
+        CPU_ = nullptr;
+        out_ << "  Request served by the buffer cache. Process returns to the Ready Queue.\n";
+        AddProcessToReadyQueue(pcb);
+        ReleaseThrottledIO();
+        BalanceLoad();
+        SwapOutBlockedProcesses();
+        return kDone;
     }
-    std::cout << "   The process in the CPU has requested " << device_name << " I/O.\n";
-    UpdatePCB_InCPU(device_name, device_num);
     PCB pcb = *CPU_; //Make copy of process in CPU
-    device_queue.push_back(pcb); //Enqueue the copy of the updated PCB to the Device Queue it requested.
     delete CPU_; //Remove the process from the CPU
     CPU_ = nullptr;
-    std::cout << "  Process from CPU has been added to Device Queue.\n";
+    if ( SubmitToDevice(pcb, device) ) //Enqueue the copy of the updated PCB to the Device Queue it requested.
+        out_ << "  Process from CPU has been added to Device Queue.\n";
     FillCPU(); //Fill CPU with next process in Ready Queue
+    ReleaseThrottledIO();
+    BalanceLoad();
+    SwapOutBlockedProcesses();
+    return kDone;
 } 
 
-void Scheduler::DeviceInterrupt(std::deque<PCB>& device_queue, std::string device_name) {
-    if (device_queue.empty()) {
-        std::cout << "     There are no processes in this queue. \n"
-                  << "     Please enter another command." << std::endl;
-        return;
+CommandStatus Scheduler::SubmitAsyncIO(Device& device, const IORequestSpec* spec) {
+    INSTRUMENT_PROBE(kProcessSyscall);
+    if (CPU_ == nullptr) {
+        out_ << "       The CPU is idle. Please add a task to the Ready Queue before requesting I/O\n";
+        return kNoProcessInCPU;
+    }
+    if (async_queue_depth_ == 0) {
+        out_ << "       Asynchronous I/O is off in this system. Please enter another command.\n";
+        return kNotAllowed;
+    }
+    AsyncQueues& queues = async_io_[CPU_->getPID()];
+    if (queues.in_flight >= async_queue_depth_) { //Submission queue is full.
+        out_ << "       P" << CPU_->getPID() << " already has " << queues.in_flight
+             << " requests in flight. Reap completions with 'r' first.\n";
+        return kNotAllowed;
+    }
+    out_ << "   The process in the CPU has submitted asynchronous " << device.Class().name << " I/O.\n";
+    UpdatePCB_InCPU(device, spec); //No CPU time is asked: the burst goes on.
+    ++io_requests_;
+    ++async_submitted_;
+    PCB request = *CPU_;
+    CPU_->setCylinder(-1);
+    if ( device.Class().cached && ServedFromCache(device) ) {
+        out_ << "  Request served by the buffer cache.\n";
+        ++queues.in_flight;
+        PostCompletion(request, device);
+    } else {
+        request.setAsync(true);
+        ++queues.in_flight;
+        if ( SubmitToDevice(request, device) ) out_ << "  Request added to Device Queue.";
+        out_ << " P" << CPU_->getPID() << " keeps running with "
+             << queues.in_flight << " requests in flight.\n";
+    }
+    ReleaseThrottledIO();
+    BalanceLoad();
+    SwapOutBlockedProcesses();
+    return kDone;
+}
+
+CommandStatus Scheduler::ReapCompletions() {
+    if (CPU_ == nullptr) {
+        out_ << "       There is no process in the CPU to reap completions. Please enter another command.\n";
+        return kNoProcessInCPU;
+    }
+    auto queues = async_io_.find( CPU_->getPID() );
+    if ( (queues == async_io_.end()) || ((queues->second.in_flight == 0) && queues->second.completions.empty()) ) {
+        out_ << "       P" << CPU_->getPID() << " has no asynchronous requests. Please enter another command.\n";
+        return kNotAllowed;
+    }
+    if ( queues->second.completions.empty() ) { //Everything is still in flight: wait for the next completion.
+        out_ << "     P" << CPU_->getPID() << " has " << queues->second.in_flight
+             << " requests in flight and leaves the CPU to wait for one.\n";
+        UpdateAccountingInfo_Syscall(*CPU_);
+        ++async_waits_;
+        reaping_.push_back(*CPU_);
+        delete CPU_;
+        CPU_ = nullptr;
+        FillCPU();
+        ReleaseThrottledIO();
+        BalanceLoad();
+        SwapOutBlockedProcesses();
+        return kDone;
+    }
+    std::deque<Completion>& completions = queues->second.completions;
+    for (auto iter = completions.begin(); iter != completions.end(); ++iter)
+        out_ << "     P" << CPU_->getPID() << " reaped its " << (iter->read_write == 'r' ? "read of " : "write of ")
+             << files_.Name(iter->file) << " on " << iter->device << ".\n";
+    async_reaped_ += completions.size();
+    completions.clear();
+    return kDone;
+}
+
+CommandStatus Scheduler::DeviceInterrupt(Device& device) {
+    INSTRUMENT_PROBE(kDeviceInterrupt);
+    if ( device.Idle() ) {
+        out_ << "     There are no processes in this queue. \n"
+             << "     Please enter another command." << std::endl;
+        return kQueueEmpty;
+    }
+    const DeviceClass& device_class = device.Class();
+    unsigned long completed_before = io_completions_;
+    if ( energy_ && (CPU_ == nullptr) ) //The idle CPU waited for the device to serve its requests.
+        energy_->Idle( energy_->ServiceMs(DeviceID(device)) );
+    for (size_t k = 0; k < device.Queues().size(); ++k) { //The queues of a device are served in parallel.
+        std::deque<PCB>& device_queue = device.Queues()[k];
+        if (device_queue.empty()) continue;
+        PCB served = device_queue.front(); //Requests merged with it are matched against its cylinder.
+        if ( device_class.cached && buffer_cache_ && (served.getRead_Write() == 'r') )
+            cache_write_backs_ += buffer_cache_->Fill( CacheBlock(device, served) );
+        PCB ready_process = served; //Make copy of the front of device queue
+        if (device_class.cylinders) ready_process.setCylinder(-1); //Reset cylinder number once disk I/O has completed. 
+        device_queue.pop_front(); //Delete this process from the device queue
+        ++io_completions_;
+        if (energy_) energy_->Serve(DeviceID(device), served.getPID());
+        if (device.Queues().size() > 1)
+            out_ << "     Channel " << k+1 << " of " << device_class.name << " " << device.Number() << " completed P"
+                 << served.getPID() << "'s request.\n";
+        CompleteRequest(ready_process, device);
+        if (io_batch_size_ > 1) MergeRequests(device_queue, served, device);
+        if ( !device_queue.empty() && !device_queue.front().IsAsync() && memory_unit_.CanResume(device_queue.front().getAddressSpace()) ) 
+            memory_unit_.SwapIn(device_queue.front().getAddressSpace()); //The device now serves this process and needs its buffer.
+    }
+    ++io_interrupts_;
+    ++interrupts_by_kind_[device.Kind()];
+    completions_by_kind_[device.Kind()] += io_completions_ - completed_before;
+    busy_us_by_kind_[device.Kind()] += device.ServiceTimeUs();
+    ReleaseThrottledIO();
+    BalanceLoad();
+    SwapOutBlockedProcesses();
+    return kDone;
+}
+
+void Scheduler::CompleteIO(PCB& a_process) {
+    if ( !memory_unit_.IsSwappedOut(a_process.getAddressSpace()) )
+        AddProcessToReadyQueue(a_process); //Add this copy to the Ready Queue
+    else if ( suspended_.empty() && memory_unit_.CanResume(a_process.getAddressSpace()) ) {
+        memory_unit_.SwapIn(a_process.getAddressSpace());
+        AddProcessToReadyQueue(a_process);
+    } else {
+        out_ << "     P" << a_process.getPID() << " is swapped out and waits for memory to be ready to run.\n";
+        suspended_.push_back(a_process);
+    }
+}
+
+void Scheduler::CompleteRequest(PCB& request, const Device& device) {
+    files_.Close( request.getFile() );
+    if ( request.IsAsync() ) PostCompletion(request, device);
+    else CompleteIO(request);
+}
+
+void Scheduler::PostCompletion(const PCB& request, const Device& device) {
+    Completion completion;
+    completion.device = std::string(device.Class().name) + " " + std::to_string(device.Number());
+    completion.file = request.getFile();
+    completion.read_write = request.getRead_Write();
+    AsyncQueues& queues = async_io_[request.getPID()];
+    --queues.in_flight;
+    ++async_completed_;
+    out_ << "     P" << request.getPID() << "'s asynchronous request for " << files_.Name(completion.file) << " on "
+         << completion.device << " has completed.\n";
+    for (auto iter = reaping_.begin(); iter != reaping_.end(); ++iter)
+        if (iter->getPID() == request.getPID()) { //It was waiting for this: it reaps it and is ready to run.
+            PCB ready_process = *iter;
+            reaping_.erase(iter);
+            ++async_reaped_;
+            out_ << "     P" << request.getPID() << " reaped it and returns to the Ready Queue.\n";
+            CompleteIO(ready_process);
+            return;
+        }
+    ++async_overlapped_;
+    queues.completions.push_back(completion);
+}
+
+void Scheduler::CancelAsyncIO(int the_PID) {
+    auto queues = async_io_.find(the_PID);
+    if (queues == async_io_.end()) return;
+    if (queues->second.in_flight > 0) {
+        for (auto iter = throttled_io_.begin(); iter != throttled_io_.end(); )
+            if ( iter->request.IsAsync() && (iter->request.getPID() == the_PID) ) iter = throttled_io_.erase(iter);
+            else ++iter;
+        for (int kind = 0; kind < kNumDeviceKinds; ++kind)
+            for (size_t i = 0; i < devices_[kind].size(); ++i)
+                for (size_t k = 0; k < devices_[kind][i]->Queues().size(); ++k) {
+                    std::deque<PCB>& device_queue = devices_[kind][i]->Queues()[k];
+                    for (auto iter = device_queue.begin(); iter != device_queue.end(); )
+                        if ( iter->IsAsync() && (iter->getPID() == the_PID) ) {
+                            files_.Close( iter->getFile() );
+                            iter = device_queue.erase(iter);
+                        } else
+                            ++iter;
+                }
+        out_ << "     P" << the_PID << "'s " << queues->second.in_flight << " asynchronous requests in flight were cancelled.\n";
+    }
+    async_io_.erase(queues);
+}
+
+void Scheduler::MergeRequests(std::deque<PCB>& device_queue, const PCB& served, const Device& device) {
+    int batch = 1;
+    int looked = 0;
+    auto iter = device_queue.begin();
+    while ( (iter != device_queue.end()) && (looked < merge_window_) && (batch < io_batch_size_) ) {
+        ++looked;
+        bool same_file = (iter->getFile() == served.getFile()) && (iter->getRead_Write() == served.getRead_Write());
+        if ( !same_file || (device.Class().cylinders && (std::abs(iter->getCylinder() - served.getCylinder()) > 1)) ) {
+            ++iter;
+            continue;
+        }
+        PCB ready_process = *iter;
+        iter = device_queue.erase(iter);
+        if (device.Class().cylinders) ready_process.setCylinder(-1);
+        out_ << "     P" << ready_process.getPID() << "'s request for " << files_.Name( ready_process.getFile() )
+             << " was merged and completed with P" << served.getPID() << "'s.\n";
+        ++batch;
+        ++io_completions_;
+        ++merged_requests_;
+        CompleteRequest(ready_process, device);
     }
-    if (device_name == "disk") device_queue.front().setCylinder(-1); //Reset cylinder number once disk I/O has completed. 
-    PCB ready_process = device_queue.front(); //Make copy of the front of device queue
-    AddProcessToReadyQueue(ready_process); //Add this copy to the Ready Queue
-    device_queue.pop_front(); //Delete this process from the device queue
 }
 
-void Scheduler::KillProcess(int the_PID) {
-    std::cout << "   Request to kill P" << the_PID << " received.\n";
+bool Scheduler::ServedFromCache(const Device& device) {
+    if (!buffer_cache_) return false;
+    if ( (flush_interval_ > 0) && (++requests_since_flush_ >= flush_interval_) ) {
+        cache_write_backs_ += buffer_cache_->Flush();
+        ++cache_flushes_;
+        requests_since_flush_ = 0;
+    }
+    std::string block = CacheBlock(device, *CPU_);
+    if (CPU_->getRead_Write() == 'r') return buffer_cache_->Read(block);
+    cache_write_backs_ += buffer_cache_->Write(block);
+    return true;
+}
+
+std::string Scheduler::CacheBlock(const Device& device, const PCB& a_process) const {
+    return std::to_string(device.Number()) + ":" + std::to_string( a_process.getFile() );
+}
+
+CommandStatus Scheduler::KillProcess(int the_PID) {
+    out_ << "   Request to kill P" << the_PID << " received.\n";
+    CancelAsyncIO(the_PID); //Its asynchronous requests leave the device queues, so only the process is found below.
     //Find Process. First check CPU:
-    if ( CPU_->getPID() == the_PID ) {
+    if ( (CPU_ != nullptr) && (CPU_->getPID() == the_PID) ) {
         TerminateProcessInCPU(); //Process to kill is in CPU. 
     }
     else if ( memory_unit_.ProcessInJobPool(the_PID) ) { //Next check Job Pool
         memory_unit_.KillProcessInJobPool(the_PID); //Delete this process
+        real_time_tasks_.erase(the_PID);
         LoadProcesses(); //Give newly available memory to next process in Job Pool
     }
-    else if ( FindPCBAndKill_CheckReadyQ(the_PID) || FindPCBAndKill_CheckPrinters(the_PID) ||  //Check device Queues and Ready Queue. If found, kill process.
-                FindPCBAndKill_CheckDisks(the_PID) || FindPCBAndKill_CheckCD_RW(the_PID) ) {
+    else if ( FindPCBAndKill_CheckReadyQ(the_PID) || FindPCBAndKill_CheckDevices(the_PID) ||  //Check device Queues and Ready Queue. If found, kill process.
+                FindPCBAndKill_CheckSuspended(the_PID) ||
+                FindPCBAndKill_CheckReaping(the_PID) || FindPCBAndKill_CheckThrottled(the_PID) ) {
         LoadProcesses(); //Give newly available memory to next process in Job Pool
     }
-    else 
-        std::cout << "       No process with this PID is still in the system to Kill. Enter another command.\n";
+    else {
+        out_ << "       No process with this PID is still in the system to Kill. Enter another command.\n";
+        return kNoSuchProcess;
+    }
+    return kDone;
 }
 
 bool Scheduler::FindPCBAndKill_CheckReadyQ(int the_PID) {
     auto rq_iter = Ready_Queue_.begin();
     while ( rq_iter != Ready_Queue_.end() ) { //Iteratively search Ready Queue
         if (rq_iter->getPID() == the_PID ) {
-            PCB PCB_to_be_killed = *rq_iter; //Make a copy of PCB to be killed because std::multiset doesn't allow elements to be modified.
-            TerminatingProcessAccounting(*rq_iter); //Update the copy
-            Ready_Queue_.erase(rq_iter); //Delete original process from Ready Queue
-            std::cout << "     P" << rq_iter->getPID() << " (located in Ready Queue) has been killed.\n";
+            PCB PCB_to_be_killed = LeaveReadyQueue(rq_iter); //Make a copy of PCB to be killed and delete the original from Ready Queue
+            TerminatingProcessAccounting(PCB_to_be_killed); //Update the copy
+            out_ << "     P" << the_PID << " (located in Ready Queue) has been killed.\n";
             return true;
         }
         ++rq_iter;
@@ -304,124 +1027,554 @@ bool Scheduler::FindPCBAndKill_CheckReadyQ(int the_PID) {
     return false;
 }
 
-bool Scheduler::FindPCBAndKill_CheckPrinters(int the_PID) {
-    for (size_t i = 0; i < printer_.size(); ++i)
-        for (auto iter = begin(printer_[i]); iter != end(printer_[i]); ++iter)
-            if (iter->getPID() == the_PID) {
-                std::cout << "     P" << iter->getPID() << " (located in printer " << i << ") has been killed.\n";
-                TerminatingProcessAccounting(*iter); 
-                printer_[i].erase(iter);
-                return true;
-            }
+bool Scheduler::FindPCBAndKill_CheckDevices(int the_PID) {
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind)
+        for (size_t i = 0; i < devices_[kind].size(); ++i) {
+            Device& device = *devices_[kind][i];
+            for (size_t k = 0; k < device.Queues().size(); ++k)
+                for (auto iter = begin(device.Queues()[k]); iter != end(device.Queues()[k]); ++iter)
+                    if (iter->getPID() == the_PID) {
+                        out_ << "     P" << iter->getPID() << " (located in " << device.Class().name << " "
+                             << device.Number();
+                        if (device.Queues().size() > 1) out_ << " channel " << k+1;
+                        out_ << ") has been killed.\n";
+                        TerminatingProcessAccounting(*iter);
+                        files_.Close( iter->getFile() );
+                        device.Queues()[k].erase(iter);
+                        return true;
+                    }
+        }
     return false;
 }
-bool Scheduler::FindPCBAndKill_CheckCD_RW(int the_PID) {
-    for (size_t i = 0; i < CD_RW_.size(); ++i) {
-        for (auto iter = begin(CD_RW_[i]); iter != end(CD_RW_[i]); ++iter) {
-            if (iter->getPID() == the_PID) {
-                std::cout << "     P" << iter->getPID() << " (located in CD_RW " << i << ") has been killed.\n";
-                TerminatingProcessAccounting(*iter); 
-                CD_RW_[i].erase(iter);
-                return true;
-            }
+
+bool Scheduler::FindPCBAndKill_CheckSuspended(int the_PID) {
+    for (auto iter = begin(suspended_); iter != end(suspended_); ++iter)
+        if (iter->getPID() == the_PID) {
+            out_ << "     P" << iter->getPID() << " (suspended) has been killed.\n";
+            TerminatingProcessAccounting(*iter);
+            suspended_.erase(iter);
+            return true;
         }
-    }
     return false;
 }
-bool Scheduler::FindPCBAndKill_CheckDisks(int the_PID) {
-    for (size_t i = 0; i < disk_.size(); ++i) {
-        for (auto iter = begin(disk_[i]); iter != end(disk_[i]); ++iter) {
-            if (iter->getPID() == the_PID) {
-                std::cout << "     P" << iter->getPID() << " (located in disk " << i << ") has been killed.\n";
-                TerminatingProcessAccounting(*iter);
-                disk_[i].erase(iter);
-                return true;
-            }
+
+bool Scheduler::FindPCBAndKill_CheckReaping(int the_PID) {
+    for (auto iter = begin(reaping_); iter != end(reaping_); ++iter)
+        if (iter->getPID() == the_PID) {
+            out_ << "     P" << iter->getPID() << " (waiting for asynchronous I/O) has been killed.\n";
+            TerminatingProcessAccounting(*iter);
+            reaping_.erase(iter);
+            return true;
+        }
+    return false;
+}
+
+bool Scheduler::FindPCBAndKill_CheckThrottled(int the_PID) {
+    for (auto iter = begin(throttled_io_); iter != end(throttled_io_); ++iter)
+        if (iter->request.getPID() == the_PID) {
+            out_ << "     P" << the_PID << " (held by the I/O limit of its group) has been killed.\n";
+            TerminatingProcessAccounting(iter->request);
+            throttled_io_.erase(iter);
+            return true;
         }
-    }
     return false;
 }
 
 void Scheduler::TerminatingProcessAccounting(const PCB& process_to_kill) {
-    std::cout << "     Total CPU Usage for this process: " << process_to_kill.getCPU_Usage() << std::endl
-              << "     Average burst for this process: " << process_to_kill.getAvgBurst() << std::endl;
+    out_ << "     Total CPU Usage for this process: " << process_to_kill.getCPU_Usage() << std::endl
+         << "     Average burst for this process: " << process_to_kill.getAvgBurst() << std::endl
+         << "     Longest wait in the Ready Queue for this process: " << process_to_kill.getMaxWait() << std::endl;
+    auto task = real_time_tasks_.find( process_to_kill.getPID() );
+    if ( task != real_time_tasks_.end() ) {
+        out_ << "     Deadlines missed by this task: " << task->second.misses << " of " << task->second.jobs << " jobs\n";
+        real_time_tasks_.erase(task);
+    }
     ++num_terminated_processes_;
+    if (energy_) energy_->CompleteJob( process_to_kill.getPID() );
     avg_CPU_usage_ = avg_CPU_usage_ * ((num_terminated_processes_-1)/num_terminated_processes_) + (process_to_kill.getCPU_Usage()/num_terminated_processes_); 
         
-    memory_unit_.FreeMemory( process_to_kill.getPID() ); //Free the memory that had been assigned to this process. 
+    auto threads = num_threads_.find( process_to_kill.getAddressSpace() );
+    if ( threads != num_threads_.end() ) { //Other threads still use the memory.
+        if (--threads->second == 1) num_threads_.erase(threads);
+        return;
+    }
+    memory_unit_.FreeMemory( process_to_kill.getAddressSpace() ); //Free the memory that had been assigned to this process. 
 }
 
 void Scheduler::AddProcessToReadyQueue(PCB& a_process) {
-    Ready_Queue_.insert(a_process); 
+    INSTRUMENT_PROBE(kAddProcessToReadyQueue);
     if (CPU_ == nullptr) { // The ready queue is empty and this process will go directly into the CPU 
+        EnterReadyQueue(a_process);
         FillCPU();
         return;
     }
-    std::cout << "     Process arriving to Ready Queue. P" << CPU_->getPID() <<" leaves CPU so that\n"
-              << "     Interrupt can be handled. \n";
-    UpdateAccountingInfo_Interrupt();
+    out_ << "     Process arriving to Ready Queue. P" << CPU_->getPID() <<" is interrupted so that\n"
+         << "     Interrupt can be handled. \n";
+    UpdateAccountingInfo_Interrupt(); //The arrival happens once the running burst's time has passed.
+    EnterReadyQueue(a_process);
+    ++arrivals_while_running_;
+    const PCB& first = *NextToRun();
+    //SJF: how much sooner the first process in the Ready Queue is expected to finish than the running one, with aging.
+    //Real-time: how much earlier its deadline or shorter its period is.
+    double gain_ms = CPU_->PriorityKey(clock_ms_, aging_rate_, real_time_policy_ == 'r') - first.getReadyKey();
+    bool other_group = !first.IsRealTime() && (first.getGroup() != CPU_->getGroup());
+    bool preempt;
+    if ( first.IsRealTime() != CPU_->IsRealTime() ) preempt = first.IsRealTime(); //Real-time tasks run before SJF.
+    else if ( first.IsRealTime() ) preempt = gain_ms > 0; //Deadlines come before the cost of a switch.
+    else if (other_group) //Groups take the CPU by share, not by burst.
+        preempt = groups_.NormalizedUsage( CPU_->getGroup() ) > groups_.NormalizedUsage( first.getGroup() );
+    else preempt = (context_switch_us_ == 0) ? (gain_ms >= 0) : (gain_ms * 1000 > context_switch_us_);
+    if (!preempt) {
+        const char* reason = "it is expected to finish first.\n";
+        if ( CPU_->IsRealTime() ) reason = "it has the higher priority.\n";
+        else if (other_group) reason = "its group is further below its CPU share.\n";
+        else if (gain_ms >= 0) {
+            ++preemptions_not_worth_cost_;
+            reason = "preempting would gain less than a context switch costs.\n";
+        }
+        out_ << "     P" << CPU_->getPID() << " keeps the CPU: " << reason;
+        return;
+    }
+    ++preemptions_;
     PCB preempted_process = *CPU_; //make a copy of process in CPU and put it back into the Ready Queue
-    Ready_Queue_.insert(preempted_process);
+    EnterReadyQueue(preempted_process);
     delete CPU_;
     CPU_ = nullptr;
     FillCPU();
-} //int num_pages, int page_size
-
-void Scheduler::UpdatePCB_InCPU(std::string device_name, int device_num){
-    CPU_->setFileNameFromUser();
-    int num_pages_for_process = ceil( CPU_->getSizeOfProcess() / memory_unit_.GetPageSize() );
-    CPU_->setStartAddressFromUser(num_pages_for_process, memory_unit_.GetPageSize());
-    memory_unit_.DisplayPhysicalAddress( CPU_->getLogicalStartAddress(), CPU_->getPID() ); 
-    if (device_name != "printer")
-        CPU_->setRead_WriteFromUser();
-    else //Printer I/O requested; write only
+}
+
+void Scheduler::EnterReadyQueue(PCB& a_process) {
+    a_process.EnterReadyQueue(clock_ms_, aging_rate_, real_time_policy_ == 'r');
+    Ready_Queue_.insert(a_process);
+    ready_by_age_.insert( std::make_pair(clock_ms_, a_process.getPID()) );
+}
+
+std::multiset<PCB, ReadyOrder>::iterator Scheduler::NextToRun() {
+    auto next = Ready_Queue_.begin();
+    if ( !groups_.Enabled() || (next == Ready_Queue_.end()) || next->IsRealTime() ) return next;
+    double least_usage = groups_.NormalizedUsage( next->getGroup() );
+    std::set<int> groups_seen;
+    for (auto iter = next; (iter != Ready_Queue_.end()) && (groups_seen.size() < groups_.Size()); ++iter) {
+        if ( !groups_seen.insert(iter->getGroup()).second ) continue; //Only the first process of a group, in SJF order.
+        double usage = groups_.NormalizedUsage( iter->getGroup() );
+        if (usage < least_usage) {
+            next = iter;
+            least_usage = usage;
+        }
+    }
+    return next;
+}
+
+PCB Scheduler::LeaveReadyQueue(std::multiset<PCB, ReadyOrder>::iterator position) {
+    PCB a_process = *position;
+    double wait = a_process.LeaveReadyQueue(clock_ms_);
+    if (wait > max_wait_ms_) max_wait_ms_ = wait;
+    total_wait_ms_ += wait;
+    ++num_waits_;
+    ready_by_age_.erase( std::make_pair(a_process.getReadySince(), a_process.getPID()) );
+    starving_.erase( a_process.getPID() );
+    Ready_Queue_.erase(position);
+    return a_process;
+}
+
+void Scheduler::AdvanceClock(int usage_ms) {
+    clock_ms_ += usage_ms;
+    if (starvation_ms_ == 0) return;
+    for (auto iter = ready_by_age_.begin(); iter != ready_by_age_.end(); ++iter) { //Oldest first: stop at the first short wait.
+        if (clock_ms_ - iter->first < starvation_ms_) break;
+        if ( !starving_.insert(iter->second).second ) continue; //Already raised for this wait.
+        ++starvation_alarms_;
+        out_ << "     Starvation alarm: P" << iter->second << " has waited " << clock_ms_ - iter->first
+             << " ms in the Ready Queue.\n";
+    }
+}
+
+bool Scheduler::SubmitToDevice(const PCB& request, Device& device) {
+    if ( !groups_.TakeIOToken(request.getGroup(), DeviceID(device), clock_ms_) ) {
+        ThrottledRequest throttled = { request, &device, clock_ms_ };
+        throttled_io_.push_back(throttled);
+        out_ << "  Group " << request.getGroup() << " has reached its I/O limit for " << device.Class().name << " "
+             << device.Number() << ". The request waits to be sent.\n";
+        return false;
+    }
+    device.Submit(request);
+    files_.Open( request.getFile() );
+    return true;
+}
+
+void Scheduler::ReleaseThrottledIO() {
+    if ( throttled_io_.empty() ) return;
+    if ( (CPU_ == nullptr) && Ready_Queue_.empty() ) { //Nothing can run: the CPU idles until a request may be sent.
+        double next = -1.0;
+        for (auto iter = throttled_io_.begin(); iter != throttled_io_.end(); ++iter) {
+            double time = groups_.NextIOTime(iter->request.getGroup(), DeviceID(*iter->device), clock_ms_);
+            if ( (next < 0) || (time < next) ) next = time;
+        }
+        if (next > clock_ms_) {
+            out_ << "     The CPU idles " << next - clock_ms_ << " ms until a request may pass its group's I/O limit.\n";
+            io_limit_idle_ms_ += next - clock_ms_;
+            if (energy_) energy_->Idle(next - clock_ms_);
+            clock_ms_ = next;
+        }
+    }
+    for (auto iter = throttled_io_.begin(); iter != throttled_io_.end(); ) {
+        const PCB& request = iter->request;
+        if ( !groups_.TakeIOToken(request.getGroup(), DeviceID(*iter->device), clock_ms_) ) {
+            ++iter;
+            continue;
+        }
+        groups_.CountIODelay(request.getGroup(), clock_ms_ - iter->since);
+        out_ << "     P" << request.getPID() << "'s request is sent to " << iter->device->Class().name << " "
+             << iter->device->Number() << " after " << clock_ms_ - iter->since << " ms.\n";
+        iter->device->Submit(request);
+        files_.Open( request.getFile() );
+        iter = throttled_io_.erase(iter);
+    }
+}
+
+void Scheduler::UpdatePCB_InCPU(const Device& device, const IORequestSpec* request){
+    if (request == nullptr) {
+        CPU_->setFileFromUser(in_, out_, files_);
+        int num_pages_for_process = memory_unit_.PagesForProcess( CPU_->getSizeOfProcess() );
+        CPU_->setStartAddressFromUser(in_, out_, num_pages_for_process, memory_unit_.GetPageSize());
+    } else {
+        CPU_->setFile( files_.Intern(request->file) );
+        CPU_->setLogicalStartAddress(request->address);
+    }
+    memory_unit_.ReferencePage( CPU_->getAddressSpace(), CPU_->getLogicalStartAddress() / memory_unit_.GetPageSize() ); //I/O buffer is touched
+    memory_unit_.DisplayPhysicalAddress( CPU_->getLogicalStartAddress(), CPU_->getAddressSpace() ); 
+    if (!device.Class().read_write) //Printer I/O requested; write only
         CPU_->setRead_Write('w');
-    CPU_->setFileLenFromUser();
-    if (device_name == "disk") {
-        int cyl = WhichCylinder(device_num);
+    else if (request == nullptr)
+        CPU_->setRead_WriteFromUser(in_, out_);
+    else
+        CPU_->setRead_Write(request->read_write);
+    if (request == nullptr) CPU_->setFileLenFromUser(in_, out_);
+    else CPU_->setFileLen(request->length);
+    files_.CountIO( CPU_->getFile(), CPU_->getRead_Write(), CPU_->getFileLen() );
+    if (device.Class().cylinders) {
+        int cyl = (request == nullptr) ? WhichCylinder(device) : request->cylinder;
         CPU_->setCylinder(cyl); //update PCB to hold this cylinder value.
     }
-    UpdateAccountingInfo_Syscall(*CPU_);
 }
 
-int Scheduler::WhichCylinder(int device_num) {
-    std::cout << "     There are " << num_cylinders_per_disk_[device_num-1] << " cylinders on this disk. \n"
-              << "     Which cylinder do you want to access? ";
-    int cyl = SchedulerNamespace::GetPositiveIntFromUser();
-    while ((cyl <= 0 ) || (cyl > num_cylinders_per_disk_[device_num-1])) { //Make sure cylinder provided is not over or under the number of cylinders this disk has. 
-        std::cout << "       Attemp to access invalid cylinder. Try again. ";
-        cyl = SchedulerNamespace::GetPositiveIntFromUser();
+bool Scheduler::ValidRequest(const Device& device, const IORequestSpec& request) const {
+    size_t num_pages = memory_unit_.PagesForProcess( CPU_->getSizeOfProcess() );
+    if ( !SchedulerNamespace::OneWord(request.file) || (request.address < 0) || (request.length < 0) ) return false;
+    if ( (size_t)request.address / memory_unit_.GetPageSize() >= num_pages ) return false;
+    if ( device.Class().read_write && (request.read_write != 'r') && (request.read_write != 'w') ) return false;
+    return !device.Class().cylinders || ( (request.cylinder >= 1) && (request.cylinder <= device.NumCylinders()) );
+}
+
+int Scheduler::WhichCylinder(const Device& device) {
+    out_ << "     There are " << device.NumCylinders() << " cylinders on this disk. \n"
+         << "     Which cylinder do you want to access? ";
+    int cyl = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
+    while ((cyl <= 0 ) || (cyl > device.NumCylinders())) { //Make sure cylinder provided is not over or under the number of cylinders this disk has. 
+        out_ << "       Attemp to access invalid cylinder. Try again. ";
+        cyl = SchedulerNamespace::GetPositiveIntFromUser(in_, out_);
     }
     return cyl; 
 }
 
 void Scheduler::UpdateAccountingInfo_Syscall(PCB& a_pcb) {
-    std::cout << "     How long did this process use the CPU (ms)? ";
-    int usage_last_burst = SchedulerNamespace::GetPositiveIntFromUser();
+    int usage_last_burst = BurstUsage();
+    AdvanceClock(usage_last_burst);
+    groups_.ChargeCPU(a_pcb.getGroup(), usage_last_burst);
+    GenerateReferences(a_pcb, usage_last_burst);
+    if (energy_) energy_->Run(a_pcb.getPID(), usage_last_burst);
+    if (multiprocessor_)
+        multiprocessor_->RecordBurst(GangOf(a_pcb), a_pcb.getPID(), a_pcb.getCPU_UsageThisBurst() + usage_last_burst);
     a_pcb.UpdatePCBAfterSyscall(usage_last_burst, history_parameter_);
+    if ( a_pcb.HasJob() ) CompleteJob(a_pcb);
 }
 
 void Scheduler::UpdateAccountingInfo_Interrupt() {
-    std::cout << "     How long did this process use the CPU (ms)? ";
-    int usage_last_burst = SchedulerNamespace::GetPositiveIntFromUser();
+    int usage_last_burst = BurstUsage();
+    AdvanceClock(usage_last_burst);
+    groups_.ChargeCPU(CPU_->getGroup(), usage_last_burst);
+    GenerateReferences(*CPU_, usage_last_burst);
+    if (energy_) energy_->Run(CPU_->getPID(), usage_last_burst);
     CPU_->UpdatePCBAfterInterrupt(usage_last_burst);
 }
 
-void Scheduler::LoadProcesses() {
-    while ( memory_unit_.MemoryForWaitingProcesses() ) {
-        PCB a_ready_pcb = memory_unit_.AssignMemoryToProcessInJobPool();  //assign to frame, take out of free frame list, and take out of job pool
-        AddProcessToReadyQueue(a_ready_pcb);  //add to ready queue. 
+bool Scheduler::AdmitRealTime(PCB& a_process, int period, int budget, int deadline) {
+    if (deadline == 0) deadline = period;
+    RealTimeTask task = { double(period), double(budget), double(deadline), 0, 0, 0.0 };
+    std::map<int, RealTimeTask> tasks = real_time_tasks_;
+    tasks[a_process.getPID()] = task;
+    if ( !Schedulable(tasks) ) {
+        out_ << "       The real-time tasks could not all meet their deadlines with this one. Rejected. \n";
+        return false;
     }
+    real_time_tasks_.swap(tasks);
+    a_process.setRealTime(period, budget, deadline);
+    return true;
 }
 
+bool Scheduler::Schedulable(const std::map<int, RealTimeTask>& tasks) const {
+    if (real_time_policy_ == 'e') { //Exact when every deadline is the period.
+        double density = 0.0;
+        for (auto iter = tasks.begin(); iter != tasks.end(); ++iter)
+            density += iter->second.budget / iter->second.deadline;
+        return density <= 1.0;
+    }
+    for (auto task = tasks.begin(); task != tasks.end(); ++task) {
+        double response = task->second.budget;
+        double previous = 0.0;
+        while ( (response != previous) && (response <= task->second.deadline) ) { //Fixed point of the interference.
+            previous = response;
+            response = task->second.budget;
+            for (auto other = tasks.begin(); other != tasks.end(); ++other)
+                if ( (other != task) && (other->second.period <= task->second.period) )
+                    response += std::ceil(previous / other->second.period) * other->second.budget;
+        }
+        if (response > task->second.deadline) return false;
+    }
+    return true;
+}
 
+void Scheduler::CompleteJob(PCB& a_pcb) {
+    double lateness = a_pcb.CompleteJob(clock_ms_);
+    ++jobs_completed_;
+    int bucket = 0;
+    if (lateness > 0) {
+        ++deadline_misses_;
+        out_ << "     P" << a_pcb.getPID() << " missed its deadline by " << lateness << " ms.\n";
+        for (bucket = 1; (bucket < kLatenessBuckets - 1) && (lateness > (1 << (bucket - 1))); ++bucket) {}
+    }
+    ++lateness_histogram_[bucket];
+    auto task = real_time_tasks_.find( a_pcb.getPID() );
+    if ( task == real_time_tasks_.end() ) return;
+    ++task->second.jobs;
+    if (lateness > 0) ++task->second.misses;
+    if (lateness > task->second.max_lateness) task->second.max_lateness = lateness;
+}
 
+void Scheduler::AssignReferenceString(PCB& a_process) {
+    char reference_pattern = memory_unit_.ReferencePattern();
+    if (reference_pattern == 'n') return;
+    const ReferenceString::Pattern mixed[] = { ReferenceString::kSequential, ReferenceString::kStrided,
+                                               ReferenceString::kZipf, ReferenceString::kPhased };
+    ReferenceString::Pattern pattern = mixed[a_process.getPID() % 4];
+    if (reference_pattern == 's') pattern = ReferenceString::kSequential;
+    else if (reference_pattern == 't') pattern = ReferenceString::kStrided;
+    else if (reference_pattern == 'z') pattern = ReferenceString::kZipf;
+    else if (reference_pattern == 'f') pattern = ReferenceString::kPhased;
+    int num_pages = memory_unit_.PagesForProcess( a_process.getSizeOfProcess() );
+    a_process.setReferenceString( ReferenceString(pattern, num_pages, 2654435761u * a_process.getPID(),
+                                                  memory_unit_.WritePercent()) );
+}
 
+void Scheduler::GenerateReferences(PCB& a_process, int usage_ms) {
+    if ( !a_process.HasReferenceString() ) return;
+    int num_references = usage_ms * memory_unit_.ReferencesPerMs();
+    for (int i = 0; i < num_references; ++i) {
+        int page = a_process.NextPageReference();
+        memory_unit_.ReferencePage( a_process.getAddressSpace(), page, a_process.NextReferenceIsWrite() );
+    }
+}
 
+void Scheduler::LoadProcesses() {
+    INSTRUMENT_PROBE(kLoadProcesses);
+    BalanceLoad();
+    if ( !suspended_.empty() ) return; //Suspended processes get memory back before new jobs are admitted.
+    while ( memory_unit_.MemoryForWaitingProcesses() ) {
+        PCB a_ready_pcb(0, 0.0, 0);
+        if ( !memory_unit_.AssignMemoryToProcessInJobPool(a_ready_pcb) ) break; //assign to frame, take out of free frame list, and take out of job pool
+        AddProcessToReadyQueue(a_ready_pcb);  //add to ready queue. 
+    }
+}
 
+void Scheduler::BalanceLoad() {
+    if ( memory_unit_.LoadControlEnabled() && memory_unit_.Overloaded() ) {
+        std::vector<int> candidates;
+        for (auto iter = Ready_Queue_.begin(); iter != Ready_Queue_.end(); ++iter)
+            if ( !MultiThreaded(*iter) ) candidates.push_back(iter->getAddressSpace());
+        int victim = memory_unit_.ChooseSuspendVictim(candidates);
+        if (victim == -1) return; //Only the process in the CPU is left to run.
+        for (auto iter = Ready_Queue_.begin(); iter != Ready_Queue_.end(); ++iter)
+            if (iter->getAddressSpace() == victim) {
+                memory_unit_.SuspendProcess(victim);
+                suspended_.push_back( LeaveReadyQueue(iter) );
+                return;
+            }
+        return;
+    }
+    while ( !suspended_.empty() && memory_unit_.CanResume(suspended_.front().getAddressSpace()) ) {
+        PCB resumed = suspended_.front();
+        suspended_.pop_front();
+        memory_unit_.ResumeProcess(resumed.getAddressSpace());
+        AddProcessToReadyQueue(resumed);
+    }
+}
 
+void Scheduler::SwapOutBlockedProcesses() {
+    if ( !memory_unit_.SwappingEnabled() ) return;
+    size_t frames_short = 0;
+    if ( !suspended_.empty() )
+        frames_short = memory_unit_.FramesShortToSwapIn( suspended_.front().getAddressSpace() );
+    else if ( memory_unit_.JobPoolSize() > 0 )
+        frames_short = memory_unit_.FramesShortForJobPool();
+    if (frames_short == 0) return;
+    std::vector<SchedulerNamespace::SwapCandidate> candidates;
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind)
+        for (size_t i = 0; i < devices_[kind].size(); ++i)
+            for (size_t k = 0; k < devices_[kind][i]->Queues().size(); ++k) {
+                std::deque<PCB>& device_queue = devices_[kind][i]->Queues()[k];
+                for (size_t depth = 1; depth < device_queue.size(); ++depth) { //Front of the queue is being served.
+                    if ( device_queue[depth].IsAsync() ) continue; //Its process is not blocked.
+                    if ( MultiThreaded(device_queue[depth]) ) continue; //Its other threads may be running.
+                    SchedulerNamespace::SwapCandidate candidate;
+                    candidate.PID = device_queue[depth].getAddressSpace();
+                    candidate.depth = depth;
+                    candidate.gain = memory_unit_.SwapOutGain(candidate.PID);
+                    if (candidate.gain > 0) candidates.push_back(candidate);
+                }
+            }
+    size_t total_gain = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) total_gain += candidates[i].gain;
+    if (total_gain < frames_short) return; //Swapping out every blocked process would still not make room.
+    if (memory_unit_.SwapVictimPolicy() == 'b')
+        std::sort(candidates.begin(), candidates.end(), SchedulerNamespace::LongerWait);
+    else
+        std::sort(candidates.begin(), candidates.end(), SchedulerNamespace::MoreMemory);
+    size_t freed = 0;
+    for (size_t i = 0; (i < candidates.size()) && (freed < frames_short); ++i) {
+        memory_unit_.SwapOut(candidates[i].PID);
+        freed += candidates[i].gain;
+    }
+    LoadProcesses();
+}
 
+void Scheduler::DisplayIOStats() const {
+    out_ << "   I/O merging: ";
+    if (io_batch_size_ == 1) out_ << "off.\n";
+    else out_ << "up to " << std::dec << io_batch_size_ << " requests per interrupt, looking through " << merge_window_
+              << " queued requests.\n";
+    out_ << "   I/O requests: " << std::dec << io_requests_ << "  Completed: " << io_completions_ << "  Interrupts: "
+         << io_interrupts_ << "  Merged: " << merged_requests_ << "  Requests per interrupt: "
+         << (io_interrupts_ ? double(io_completions_) / io_interrupts_ : 0.0) << std::endl;
+    for (int kind = 0; kind < kNumDeviceKinds; ++kind) {
+        if ( devices_[kind].empty() ) continue;
+        std::string plural = Device::Classes(DeviceKind(kind)).plural;
+        plural[0] = std::toupper(plural[0]);
+        out_ << "   " << plural << ": " << completions_by_kind_[kind] << " requests over " << interrupts_by_kind_[kind]
+             << " interrupts, " << (interrupts_by_kind_[kind] ? double(completions_by_kind_[kind]) / interrupts_by_kind_[kind] : 0.0)
+             << " per interrupt.";
+        if (busy_us_by_kind_[kind] > 0)
+            out_ << "  Busy: " << busy_us_by_kind_[kind] << " us, "
+                 << 1000.0 * completions_by_kind_[kind] / busy_us_by_kind_[kind] << " requests per ms.";
+        out_ << std::endl;
+    }
+    if (async_queue_depth_ == 0)
+        out_ << "   Asynchronous I/O: off.\n";
+    else {
+        out_ << "   Asynchronous I/O: up to " << async_queue_depth_ << " requests in flight per process.\n"
+             << "   Submitted: " << async_submitted_ << "  Completed: " << async_completed_ << "  Reaped: "
+             << async_reaped_ << "  Waits: " << async_waits_ << "  Completed without waiting: " << async_overlapped_
+             << std::endl << "   Waiting for completions: ";
+        if ( reaping_.empty() ) out_ << "None";
+        for (auto iter = reaping_.begin(); iter != reaping_.end(); ++iter)
+            out_ << "P" << iter->getPID() << " ";
+        out_ << std::endl;
+    }
+    if (!buffer_cache_) {
+        out_ << "   Buffer cache: off.\n";
+        return;
+    }
+    unsigned long reads = buffer_cache_->ReadHits() + buffer_cache_->ReadMisses();
+    unsigned long served = buffer_cache_->ReadHits() + buffer_cache_->Writes();
+    out_ << "   Buffer cache: " << buffer_cache_->Name() << ", " << buffer_cache_->Size() << " of "
+         << buffer_cache_->Capacity() << " blocks, " << buffer_cache_->DirtyBlocks() << " dirty.\n"
+         << "   Read hits: " << buffer_cache_->ReadHits() << "  Read misses: " << buffer_cache_->ReadMisses()
+         << "  Hit ratio: " << (reads ? double(buffer_cache_->ReadHits()) / reads : 0.0) << "  Writes: "
+         << buffer_cache_->Writes() << std::endl
+         << "   Write-backs: " << cache_write_backs_ << "  Flushes: " << cache_flushes_
+         << "  Disk requests avoided: " << (served > cache_write_backs_ ? served - cache_write_backs_ : 0)
+         << std::endl;
+}
 
+void Scheduler::DisplayAging() const {
+    out_ << "   Aging: ";
+    if (aging_rate_ == 0.0) out_ << "off.";
+    else out_ << std::dec << aging_rate_ << " ms of expected burst per ms waited.";
+    out_ << "  Starvation alarm: ";
+    if (starvation_ms_ == 0) out_ << "off.\n";
+    else out_ << "after " << starvation_ms_ << " ms.  Alarms: " << starvation_alarms_ << std::endl;
+    out_ << "   Clock: " << clock_ms_ << " ms  Longest wait: " << max_wait_ms_ << " ms  Average wait: "
+         << (num_waits_ ? total_wait_ms_ / num_waits_ : 0.0) << " ms\n"
+         << "   Waiting now, oldest first: ";
+    if ( ready_by_age_.empty() ) out_ << "None";
+    for (auto iter = ready_by_age_.begin(); iter != ready_by_age_.end(); ++iter)
+        out_ << "P" << iter->second << " (" << clock_ms_ - iter->first << " ms) ";
+    out_ << std::endl;
+}
+
+void Scheduler::DisplayContextSwitches() const {
+    double switch_ms = switch_us_ / 1000.0;
+    out_ << "   Context switch cost: " << std::dec << context_switch_us_ << " us (" << context_switch_us_ - address_space_switch_us_
+         << " us between threads of a process)  Context switches: " << context_switches_ << " (" << thread_switches_
+         << " between threads)\n"
+         << "   Time spent switching: " << switch_ms << " ms ("
+         << (clock_ms_ + switch_ms > 0 ? 100.0 * switch_ms / (clock_ms_ + switch_ms) : 0.0) << "% of the CPU)\n"
+         << "   Arrivals while a process ran: " << arrivals_while_running_ << "  Preemptions: " << preemptions_
+         << "  Switches avoided: " << arrivals_while_running_ - preemptions_ << " (" << preemptions_not_worth_cost_
+         << " shorter by less than the cost)\n"
+         << "   Completed processes per second of CPU time: ";
+    if (clock_ms_ == 0) out_ << "None";
+    else out_ << 1000.0 * num_terminated_processes_ / (clock_ms_ + switch_ms) << " (" << 1000.0 * num_terminated_processes_ / clock_ms_
+              << " without switching)";
+    out_ << std::endl;
+}
 
+void Scheduler::DisplayRealTime() const {
+    out_ << "   Real-time policy: ";
+    if (real_time_policy_ == 'n') {
+        out_ << "none.\n";
+        return;
+    }
+    double utilization = 0.0;
+    for (auto iter = real_time_tasks_.begin(); iter != real_time_tasks_.end(); ++iter)
+        utilization += iter->second.budget / iter->second.period;
+    size_t n = real_time_tasks_.size();
+    out_ << (real_time_policy_ == 'e' ? "earliest deadline first" : "rate-monotonic") << ".  Tasks: " << std::dec << n
+         << "  Utilization: " << utilization;
+    if ( (real_time_policy_ == 'r') && (n > 0) ) out_ << " (Liu-Layland bound " << n * (std::pow(2.0, 1.0 / n) - 1) << ")";
+    out_ << std::endl << "   Jobs completed: " << jobs_completed_ << "  Deadline misses: " << deadline_misses_ << std::endl
+         << "   Lateness: met " << lateness_histogram_[0];
+    for (int i = 1; i < kLatenessBuckets - 1; ++i)
+        out_ << "  <=" << (1 << (i - 1)) << "ms " << lateness_histogram_[i];
+    out_ << "  >" << (1 << (kLatenessBuckets - 3)) << "ms " << lateness_histogram_[kLatenessBuckets - 1] << std::endl;
+    if (n == 0) return;
+    out_ << "PID|" << std::setw(8) << "Period|" << std::setw(8) << "Budget|" << std::setw(10) << "Deadline|"
+         << std::setw(6) << "Jobs|" << std::setw(8) << "Misses|" << std::setw(14) << "Max Lateness" << std::endl;
+    for (auto iter = real_time_tasks_.begin(); iter != real_time_tasks_.end(); ++iter)
+        out_ << iter->first << std::setw(8) << iter->second.period << std::setw(8) << iter->second.budget << std::setw(10)
+             << iter->second.deadline << std::setw(6) << iter->second.jobs << std::setw(8) << iter->second.misses
+             << std::setw(14) << iter->second.max_lateness << std::endl;
+}
 
+void Scheduler::DisplayGroups() const {
+    if ( !groups_.Enabled() ) {
+        out_ << "   Process groups: none.\n";
+        return;
+    }
+    groups_.Display(out_);
+    out_ << "   CPU idle waiting for I/O limits: " << std::dec << io_limit_idle_ms_ << " ms\n"
+         << "   Requests held by I/O limits: ";
+    if ( throttled_io_.empty() ) out_ << "None";
+    for (auto iter = throttled_io_.begin(); iter != throttled_io_.end(); ++iter)
+        out_ << "P" << iter->request.getPID() << " (" << iter->device->Class().name << " " << iter->device->Number() << ") ";
+    out_ << std::endl;
+}
 
+void Scheduler::DisplayLoadControl() const {
+    memory_unit_.DisplayLoadControl();
+    memory_unit_.DisplaySwapStats();
+    out_ << "   Swapped-out ready processes: ";
+    if ( suspended_.empty() ) out_ << "None";
+    for (auto iter = suspended_.begin(); iter != suspended_.end(); ++iter)
+        out_ << "P" << iter->getPID() << " ";
+    out_ << std::endl;
+}
@@ -14,35 +14,105 @@
 #include <string>
 #include <iostream>
 #include <set>
+#include <map>
+#include <memory>
+#include <functional>
+#include "ReferenceString.h"
+#include "BufferCache.h"
+#include "Device.h"
+#include "FileTable.h"
+#include "ProcessGroups.h"
+#include "Multiprocessor.h"
+#include "Energy.h"
 
 
+/* Ready Queue order: real-time tasks first, by deadline or period; then shortest expected remaining burst first, less
+   the credit earned by waiting (PCB::PriorityKey()). */
+struct ReadyOrder {
+    bool operator()(const PCB& lhs, const PCB& rhs) const {
+        if ( lhs.IsRealTime() != rhs.IsRealTime() ) return lhs.IsRealTime();
+        return lhs.getReadyKey() < rhs.getReadyKey();
+    }
+};
+
+/* Outcome of a command given to the Scheduler. */
+enum CommandStatus {
+    kDone, //carried out
+    kInJobPool, //the new process waits in the Job Pool for memory
+    kRejected, //the new process was turned away: too large, over its group's frame limit, or not schedulable
+    kNoProcessInCPU, //the command needs a process in the CPU and the CPU is idle
+    kQueueEmpty, //the device interrupted with no request to complete
+    kNotAllowed, //asynchronous I/O is off, the submission queue is full, or there is nothing to reap
+    kNoSuchProcess, //no process in the system has the PID
+    kBadCommand //the command is malformed or names a device this system does not have
+};
+
+/* A new process, for AddNewProcess() given its arguments. */
+struct ProcessSpec {
+    size_t size;
+    std::string program; //one word; asked only when code pages are shared
+    int group; //0 for none
+    int period; //ms; 0 for an ordinary process. A real-time task needs a real-time policy.
+    int budget; //ms of CPU time per job, from 1 to the period
+    int deadline; //ms after the release of a job, from the budget to the period; 0 for the period
+};
+
+/* An I/O request of the process in the CPU, for Syscall() and SubmitAsync(). */
+struct IORequestSpec {
+    std::string file; //one word
+    int address; //logical start address, within the process
+    char read_write; //'r' or 'w'; printers only write
+    int length;
+    int cylinder; //from 1 to the cylinders of the disk; asked only by disks
+};
+
 class Scheduler
 {
 public:
     /**
      * The constructer will interact with the user for the system generation. It will ask the user
-     * how many devices and of what kind are in the system.
+     * how many devices and of what kind are in the system. Every answer is read from in, and every
+     * question and message is written to out.
      */
-    Scheduler();
+    Scheduler(std::istream& in = std::cin, std::ostream& out = std::cout);
+
+    /* Frees the process in the CPU. */
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete; //Not copied: the process in the CPU is owned.
+    Scheduler& operator=(const Scheduler&) = delete;
     
     /**
      * When a process arrives, add_process is called to handle this. The process is given a PCB and entered
      * into the Ready Queue. If the CPU is empty, the next process in line is brought into the CPU to be
      * run.
      * Post-Condition: The CPU is executing a process.
+     * Returns kInJobPool if the process waits for memory, or kRejected if it was turned away.
      */
-    void AddNewProcess();
+    CommandStatus AddNewProcess();
     
     /**
      * When a process is finished running in the CPU, terminate_process() is called. The PCB is recycled
      * and if another process is waiting to be run, it is brought into the CPU to be run.
      * NOTE: The PID is NOT recycled.
      */
-    void TerminateProcessInCPU();
+    CommandStatus TerminateProcessInCPU();
+
+    /**
+     * The process in the CPU forks. The child gets the next PID, the parent's size and program, and shares the
+     * parent's frames copy-on-write, so it enters the Ready Queue without waiting for memory.
+     */
+    CommandStatus ForkProcessInCPU();
+
+    /**
+     * The process in the CPU creates a thread. The thread gets the next PID but shares the page table and frames of
+     * the process, so it enters the Ready Queue without any memory being assigned.
+     */
+    CommandStatus CreateThreadInCPU();
     
     /**
      * snapshot() is an interrupt. It simulates a Big Button on the Sys-op's console. It will interact with
-     * the user to see what device's queues they want to print.
+     * the user to see what device's queues they want to print, 'f' for the file table, 'g' for the process
+     * groups, 'u' for the multiprocessor model, 'e' for the energy model, or 'i' for the instrumentation counters.
      */
     void Snapshot();
     
@@ -52,14 +122,115 @@ public:
      * compatible with this system (in other words, the device they are referencing is present).
      * Pre-Condition: User input is in form "[first letter of device name][device number]"
      */
-    void ParseCommand (std::string user_input);
+    CommandStatus ParseCommand (std::string user_input);
+
+    /**
+     * The process in the CPU reaps the completions of its asynchronous requests. If none has completed yet but some
+     * are in flight, it leaves the CPU and waits for the next one.
+     */
+    CommandStatus ReapCompletions();
+
+    /**
+     * The commands above for a program that drives the Scheduler (Simulator.h): each takes its arguments instead of
+     * asking for them. usage_ms is the CPU time the process in the CPU has used, charged to every burst the command
+     * ends instead of asked for. An argument the questions would ask for again is refused with kBadCommand before
+     * anything is carried out.
+     */
+    CommandStatus AddNewProcess(const ProcessSpec& spec, int usage_ms);
+    CommandStatus TerminateProcessInCPU(int usage_ms);
+    CommandStatus ForkProcessInCPU(int usage_ms);
+    CommandStatus CreateThreadInCPU(int usage_ms);
+    /* The process in the CPU requests I/O from device number (from 1) of class kind and waits for it. */
+    CommandStatus Syscall(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms);
+    /* The process in the CPU submits an asynchronous request and keeps running. */
+    CommandStatus SubmitAsync(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms);
+    CommandStatus Interrupt(DeviceKind kind, int number, int usage_ms);
+    CommandStatus Kill(int PID, int usage_ms);
+    CommandStatus ReapCompletions(int usage_ms);
+    /* Prints the Snapshot view picked by its letter. */
+    void Snapshot(char view);
+
+    /* The process in the CPU; null if the CPU is idle. */
+    const PCB* Running() const { return CPU_; }
+    /* PID of the last process created; processes are numbered from 1. */
+    int LastPID() const { return process_counter_; }
+    size_t NumReady() const { return Ready_Queue_.size(); }
+    int NumDevices(DeviceKind kind) const { return devices_[kind].size(); }
+    /* Cylinders of disk number (from 1). */
+    int NumCylinders(int number) const { return devices_[kDisk][number-1]->NumCylinders(); }
+    /* CPU time run by the system so far, in ms. */
+    double Clock() const { return clock_ms_; }
+    double AvgCPUUsage() const { return avg_CPU_usage_; }
+    const Memory& MemoryUnit() const { return memory_unit_; }
+    /* Model of the bursts run on several CPUs; null if it was not configured. */
+    const Multiprocessor* MultiprocessorModel() const { return multiprocessor_.get(); }
+    /* Energy used by the CPU and the devices; null if it was not configured. */
+    const EnergyModel* Energy() const { return energy_.get(); }
     
 private:
-    std::vector<std::deque<PCB> > printer_;
-    std::vector<std::deque<PCB> > disk_;
-    std::vector<std::deque<PCB> > CD_RW_;
-    std::multiset<PCB> Ready_Queue_; //Ready_Queue holds all processes currently waiting to enter CPU
-    std::vector<int> num_cylinders_per_disk_; //where disk[i] has num_cylinders_per_disk[i] cylinders
+    /* A completed asynchronous request, waiting in its process's completion queue to be reaped. */
+    struct Completion {
+        std::string device; //device name and number
+        int file; //number in files_
+        char read_write;
+    };
+    /* Submission and completion queues of a process using asynchronous I/O. */
+    struct AsyncQueues {
+        int in_flight; //submitted requests not completed yet
+        std::deque<Completion> completions; //completed, not reaped yet
+    };
+    /* A real-time task admitted to the system, with the deadlines its jobs met and missed. Times are in ms. */
+    struct RealTimeTask {
+        double period;
+        double budget;
+        double deadline; //relative to the release of each job
+        unsigned long jobs; //jobs that finished their burst
+        unsigned long misses;
+        double max_lateness;
+    };
+    static const int kLatenessBuckets = 10; //met, late by up to 1, 2, 4 ... 128 ms, later
+    /* A request its group's I/O limit keeps from its device for now. */
+    struct ThrottledRequest {
+        PCB request;
+        Device* device;
+        double since; //time it was held, in ms
+    };
+
+    std::istream& in_; //Answers to the questions asked
+    std::ostream& out_; //Questions and messages
+    int usage_ms_; //CPU time given with the command being carried out; -1 if it is asked for
+    std::vector<std::unique_ptr<Device> > devices_[kNumDeviceKinds]; //devices_[kind][i] is device i+1 of that class
+    std::multiset<PCB, ReadyOrder> Ready_Queue_; //Ready_Queue holds all processes currently waiting to enter CPU
+    std::set< std::pair<double, int> > ready_by_age_; //(time entered, PID) of every process in Ready_Queue_, oldest first
+    std::set<int> starving_; //PIDs in Ready_Queue_ that have raised the starvation alarm for their current wait
+    double clock_ms_; //CPU time run by the system so far, and time idled for I/O limits; the time waits are measured in
+    double aging_rate_; //ms of expected burst a process in the Ready Queue is credited per ms it waits; 0 for no aging
+    int starvation_ms_; //Wait in the Ready Queue that raises the starvation alarm; 0 for no alarm
+    unsigned long starvation_alarms_;
+    double max_wait_ms_; //Longest wait in the Ready Queue of any process so far
+    double total_wait_ms_; //Sum of the completed waits in the Ready Queue
+    unsigned long num_waits_;
+    int context_switch_us_; //Modeled cost of a context switch: saving registers, flushing the TLB, warming the caches
+    int address_space_switch_us_; //Part of context_switch_us_ not paid between threads of the same process
+    unsigned long context_switches_; //processes placed in the CPU
+    unsigned long thread_switches_; //context switches between threads of the same process
+    double switch_us_; //Total modeled cost of the context switches
+    int last_address_space_; //Address space of the last thread placed in the CPU; -1 if none yet
+    std::map<int, int> num_threads_; //Key is address space. Live threads of the processes that have created threads.
+    unsigned long arrivals_while_running_; //arrivals to the Ready Queue that interrupted a running process
+    unsigned long preemptions_;
+    unsigned long preemptions_not_worth_cost_; //arrivals expected to finish sooner, but by less than a context switch
+    char real_time_policy_; //'e' earliest deadline first, 'r' rate-monotonic or 'n' if there are no real-time tasks
+    std::map<int, RealTimeTask> real_time_tasks_; //Key is PID. Tasks admitted and not terminated yet.
+    unsigned long jobs_completed_; //jobs of real-time tasks that finished their burst
+    unsigned long deadline_misses_;
+    unsigned long lateness_histogram_[kLatenessBuckets];
+    ProcessGroups groups_; //Limits and accounting of the process groups; only kDefaultGroup if processes are not grouped
+    std::deque<ThrottledRequest> throttled_io_; //Requests held by I/O limits, in the order they were made
+    double io_limit_idle_ms_; //Time the CPU idled because every process waited for an I/O limit
+    std::unique_ptr<Multiprocessor> multiprocessor_; //Replays the bursts on several CPUs; null if it is not modeled
+    char gang_by_; //What forms a gang in multiprocessor_: 't' the threads of a process or 'g' a process group
+    std::unique_ptr<EnergyModel> energy_; //P-states, C-states and the energy of the CPU and devices; null if not modeled
     PCB* CPU_; //The CPU holds one process at a time that it will run.
     double history_parameter_; 
     double initial_burst_estimate_; // in milliseconds 
@@ -67,13 +238,43 @@ private:
     double avg_CPU_usage_; // Rolling average of total CPU time of completed processes in milliseconds
     double num_terminated_processes_; //Number of termininated processes. Needed to compute avg_CPU_usage
     Memory memory_unit_; 
+    std::deque<PCB> suspended_; //Ready processes that are swapped out, waiting for memory, in order of arrival
+    int io_batch_size_; //Most requests a device completes with one interrupt; 1 if requests are not merged
+    int merge_window_; //Queued requests behind the one being served that a device looks through for merges
+    unsigned long io_requests_; //I/O system calls
+    unsigned long io_completions_; //requests completed by device interrupts
+    unsigned long io_interrupts_; //device interrupts that completed a request
+    unsigned long merged_requests_; //requests completed together with the one being served
+    unsigned long completions_by_kind_[kNumDeviceKinds]; //requests completed by interrupts of each device class
+    unsigned long interrupts_by_kind_[kNumDeviceKinds];
+    unsigned long busy_us_by_kind_[kNumDeviceKinds]; //service time of the interrupts: a device's queues serve in parallel
+    FileTable files_; //Every file named by an I/O request
+    std::unique_ptr<BufferCache> buffer_cache_; //Blocks of the disks, keyed by disk and file; null if there is no cache
+    int flush_interval_; //Disk requests between flushes of dirty blocks; 0 if they are written back only when evicted
+    int requests_since_flush_;
+    unsigned long cache_write_backs_; //dirty blocks written to the disks, by eviction or flush
+    unsigned long cache_flushes_;
+    int async_queue_depth_; //Most asynchronous requests a process can have in flight; 0 if I/O is only synchronous
+    std::map<int, AsyncQueues> async_io_; //Key is PID. Processes that have submitted asynchronous requests.
+    std::deque<PCB> reaping_; //Processes out of the CPU waiting for one of their asynchronous requests to complete
+    unsigned long async_submitted_;
+    unsigned long async_completed_;
+    unsigned long async_reaped_;
+    unsigned long async_waits_; //reaps that found nothing completed and left the CPU to wait
+    unsigned long async_overlapped_; //completions posted while their process was not waiting for them
     /**
      * init() is the system generator. It asks the user how many devices are on their system, as well
      * as the hostoriaal paramete, initial burst estimate and number of cylinders each disk has.
-     * The user can only have printers, disks, and CD_RW devices on their system. 
+     * Each call asks for the devices of class kind, which serve their queue first come first served.
      *0 <= historical parameter <= 1.
      */
-    void Init(std::vector<std::deque<PCB> >& device, std::string device_name);
+    void Init(DeviceKind kind);
+
+    /**
+     * Asks how many SSDs are in the system and, for each, its number of channels and the time a channel takes to
+     * serve one request.
+     */
+    void InitSSDs();
 
     /**
      * Initialize history_parameter_ by quering user. Queries user repeatedly until they enter
@@ -93,6 +294,66 @@ private:
      */
     void InitNumCylinders();
 
+    /**
+      * Asks whether to configure advanced scheduling options. If so, queries the aging rate of the Ready Queue, the
+      * wait that raises the starvation alarm, the cost of a context switch, the real-time scheduling policy, the
+      * process groups, the CPUs to model and the energy model.
+     */
+    void InitAdvancedOptions();
+
+    /**
+      * Queries the number of CPUs to model gang scheduling on and, if more than one, whether gangs are the threads
+      * of a process or process groups.
+     */
+    void InitMultiprocessor();
+
+    /**
+      * Queries the frequency governor of the energy model, if energy is modeled, and for the energy-aware governor
+      * the most it may slow a burst down.
+     */
+    void InitEnergy();
+
+    /**
+      * Queries the number of process groups and, for each, the group it is under, the most frames its processes may
+      * hold, its CPU share weight and the most I/O requests per second it may make to each device.
+     */
+    void InitGroups();
+
+    /**
+      * Asks whether to configure advanced I/O options. If so, queries the most requests a device completes with one
+      * interrupt, how many queued requests it looks through for ones to merge, and how many asynchronous requests a
+      * process can have in flight. Then queries the frames of memory given to the disk buffer cache and, if any, its
+      * replacement policy and how often dirty blocks are flushed.
+     */
+    void InitIOOptions();
+
+    /**
+      * Makes the new process a_process a real-time task with period, CPU time per period budget and deadline (0 for
+      * the period). Admits it only if every real-time task still meets its deadlines by real_time_policy_. Returns
+      * false if it is rejected.
+     */
+    bool AdmitRealTime(PCB& a_process, int period, int budget, int deadline);
+
+    /**
+      * Schedulability test of tasks under real_time_policy_. EDF: the CPU time the tasks need per ms of deadline is
+      * at most 1. Rate-monotonic: the worst-case response time of every task, interfered with by the tasks of
+      * shorter or equal period, is within its deadline.
+     */
+    bool Schedulable(const std::map<int, RealTimeTask>& tasks) const;
+
+    /* The current job of real-time task a_pcb has finished its burst. Records whether it met its deadline. */
+    void CompleteJob(PCB& a_pcb);
+
+    /**
+      * Gives a_process its reference string according to the reference pattern of memory_unit_.
+     */
+    void AssignReferenceString(PCB& a_process);
+
+    /**
+      * a_process ran in the CPU for usage_ms. Its memory references for that time are translated through memory_unit_.
+     */
+    void GenerateReferences(PCB& a_process, int usage_ms);
+
     /**
      * If CPU is empty, fill_CPU will give CPU a process to run.
      * Pre-Condition: CPU and Ready Queue may or may not be empty.
@@ -101,16 +362,16 @@ private:
     void FillCPU();
 
     /**
-     * Prints all of the queues in the vector to the screen. Each element in seperated
+     * Prints all of the queues of the devices of class kind to the screen. Each element in seperated
      * by a space, and each queue is seperated by a new line. If a queue is empty, message is displayed.
      * Prints page table for element of each device. 
      */
-    void DisplayQueues(std::vector<std::deque<PCB> >& device, char first_letter) const;
+    void DisplayQueues(DeviceKind kind);
 
     /**
-      * Print the page table for every process in device passed as argument.
+      * Print the page table for every process in device_queue, labeled by label.
      */
-    void DisplayPageTables(std::vector<std::deque<PCB> >& device, char first_letter, int which_device) const;
+    void DisplayPageTables(const std::deque<PCB>& device_queue, const std::string& label) const;
     /**
       * Print the page table for every process in Ready Queue.
      */
@@ -127,43 +388,165 @@ private:
     void DisplayReadyQueue() const;
     
     /**
-      * A process in the CPU requests I/O from a device. If the device exists, the process is added to the
-      * device queue and a process from the Ready Queue is placed in the CPU.
+      * A process in the CPU requests I/O from a device. The process is added to the device's queue and a process from
+      * the Ready Queue is placed in the CPU. The request is spec, or asked for if spec is null.
+     */
+    CommandStatus ProcessSyscall(Device& device, const IORequestSpec* spec = nullptr);
+
+    /**
+      * The process in the CPU submits an asynchronous request to a device and keeps running. The request waits in the
+      * device queue in its own PCB copy; its completion is posted to the process's completion queue. The request is
+      * spec, or asked for if spec is null.
      */
-    void ProcessSyscall(std::deque<PCB>& device_queue, std::string device_name, int device_num);
+    CommandStatus SubmitAsyncIO(Device& device, const IORequestSpec* spec = nullptr);
     
     /**
       * An interrupt is generated by the device when a task in the device's queue is completed. The PCB for
-      * this task is returned to the Ready Queue.
+      * this task is returned to the Ready Queue. Queues of a device served in parallel each complete the task at
+      * their front with the same interrupt.
+     */
+    CommandStatus DeviceInterrupt(Device& device);
+
+    /**
+      * The request of a_process at the front of a device queue has been served. Returns it to the Ready Queue, swapping
+      * it back in first if it was swapped out, or leaves it in suspended_ if memory cannot take it yet.
+     */
+    void CompleteIO(PCB& a_process);
+
+    /**
+      * A device has served request. Posts it to its process's completion queue if it was asynchronous, else completes
+      * the process's I/O.
+     */
+    void CompleteRequest(PCB& request, const Device& device);
+
+    /**
+      * Posts the completed asynchronous request to the completion queue of its process. A process waiting in reaping_
+      * reaps it and returns to the Ready Queue.
+     */
+    void PostCompletion(const PCB& request, const Device& device);
+
+    /* Removes the asynchronous requests of the_PID from every device queue and discards its completion queue. */
+    void CancelAsyncIO(int the_PID);
+
+    /**
+      * The device has just served the request of served. Completes with the same interrupt the requests among the next merge_window_
+      * in device_queue for the same file in the same direction (on a disk, also on the same or an adjacent cylinder),
+      * up to io_batch_size_ requests in all.
      */
-    void DeviceInterrupt(std::deque<PCB>& device_queue, std::string device_name);
+    void MergeRequests(std::deque<PCB>& device_queue, const PCB& served, const Device& device);
+
+    /**
+      * The process in the CPU has just requested I/O from a cached device. Returns true if the buffer cache serves
+      * it: a read of a cached block, or any write (written back later). Counts the request towards the next flush.
+     */
+    bool ServedFromCache(const Device& device);
+
+    /* Buffer cache block that the request of a_process on device reads or writes. */
+    std::string CacheBlock(const Device& device, const PCB& a_process) const;
     
     /**
       * Pre-Condition: There is a process in the system with PID the_PID. 
       * Post-Condition: This process is terminated and its memory is recycled. 
      */
-    void KillProcess(int the_PID); 
+    CommandStatus KillProcess(int the_PID); 
 
-    bool FindPCBAndKill_CheckDisks(int the_PID);
-    bool FindPCBAndKill_CheckCD_RW(int the_PID);
-    bool FindPCBAndKill_CheckPrinters(int the_PID);
+    bool FindPCBAndKill_CheckDevices(int the_PID);
     bool FindPCBAndKill_CheckReadyQ(int the_PID);
+    bool FindPCBAndKill_CheckSuspended(int the_PID);
+    bool FindPCBAndKill_CheckReaping(int the_PID);
+    bool FindPCBAndKill_CheckThrottled(int the_PID);
+
+    /* Gang of a_process in multiprocessor_: its address space, or minus its group if gangs are groups. */
+    int GangOf(const PCB& a_process) const {
+        if ( (gang_by_ == 'g') && (a_process.getGroup() != ProcessGroups::kDefaultGroup) ) return -a_process.getGroup();
+        return a_process.getAddressSpace();
+    }
+
+    /* True if another thread shares the address space of a_process. Such processes are never swapped out. */
+    bool MultiThreaded(const PCB& a_process) const { return num_threads_.count( a_process.getAddressSpace() ) > 0; }
 
     /*
-     * Collects all accounting information from terminated process. 
+     * Collects all accounting information from terminated process. Its memory is freed with the last of its threads.
     */
     void TerminatingProcessAccounting(const PCB& process_to_kill); 
 
+    /**
+      * Sends request to device if the I/O limits of its group let it through now and returns true. Otherwise holds it
+      * in throttled_io_ and returns false.
+     */
+    bool SubmitToDevice(const PCB& request, Device& device);
+
+    /**
+      * Sends the requests in throttled_io_ that their groups' I/O limits now let through. If nothing can run, the CPU
+      * first idles until one of them may be sent.
+     */
+    void ReleaseThrottledIO();
+
+    /* Number telling device apart from every other device, for the I/O limits of groups_. */
+    int DeviceID(const Device& device) const { return device.Kind() + kNumDeviceKinds * device.Number(); }
+
     /**
       * Internal method for when I/O is requested by a process in the CPU and therefore the PCB of this
-      * process needs to be updated.
+      * process needs to be updated. The request is asked for if it is not given.
+     */
+    void UpdatePCB_InCPU(const Device& device, const IORequestSpec* request = nullptr);
+
+    /* True if request is one the questions of UpdatePCB_InCPU() would accept from the process in the CPU. */
+    bool ValidRequest(const Device& device, const IORequestSpec& request) const;
+
+    /* True if the system has device number (from 1) of class kind. */
+    bool HasDevice(DeviceKind kind, int number) const {
+        return (kind >= 0) && (kind < kNumDeviceKinds) && (number > 0) && ((size_t)number <= devices_[kind].size());
+    }
+
+    /* Creates the process spec describes, rejecting it if it is too large, over its group's limit or not schedulable. */
+    CommandStatus CreateProcess(const ProcessSpec& spec);
+
+    /**
+      * Carries out command with usage_ms as the CPU time of every burst it ends instead of asking for it. Returns
+      * kBadCommand if usage_ms is negative.
      */
-    void UpdatePCB_InCPU(std::string device_name, int device_num);
+    CommandStatus WithUsage(int usage_ms, const std::function<CommandStatus()>& command);
+
+    /* CPU time of the burst ending now: the one given with the command, else asked for. */
+    int BurstUsage();
 
     /**
-      * Add a process to the Ready_Queue, using SJF Pre-emptive CPU Scheduling. 
+      * Add a process to the Ready_Queue, using SJF Pre-emptive CPU Scheduling. The running process is preempted only
+      * if the first process in the Ready Queue is expected to finish its burst sooner by more than a context switch
+      * costs (by any time, ties included, if the cost is 0). Real-time tasks preempt the SJF class, and each other by
+      * priority alone.
     */
     void AddProcessToReadyQueue(PCB& a_process);
+
+    /**
+      * Process the CPU takes next. Without groups, the first in Ready_Queue_. With groups, a real-time task if one is
+      * first, else the first process, in SJF order, of the group whose CPU time is furthest below its share.
+     */
+    std::multiset<PCB, ReadyOrder>::iterator NextToRun();
+
+    /* Inserts a_process into Ready_Queue_ at the current time, by its aged order. */
+    void EnterReadyQueue(PCB& a_process);
+
+    /* Removes the process at position from Ready_Queue_, recording its wait. Returns it. */
+    PCB LeaveReadyQueue(std::multiset<PCB, ReadyOrder>::iterator position);
+
+    /* Advances clock_ms_ by usage_ms of CPU time, then raises the starvation alarm for processes waiting too long. */
+    void AdvanceClock(int usage_ms);
+
+    /* Prints the aging rate, the waits in the Ready Queue and the starvation alarms. */
+    void DisplayAging() const;
+
+    /* Prints the context switch cost, the switches and preemptions made and avoided, and the CPU time they took. */
+    void DisplayContextSwitches() const;
+
+    /* Prints every process group with its limits and use of the CPU, frames and I/O, and the requests held by I/O
+       limits. */
+    void DisplayGroups() const;
+
+    /* Prints the real-time policy, the utilization of the tasks, deadline misses with a histogram of lateness, and
+       each task. */
+    void DisplayRealTime() const;
     
     /*
      * Pre-Condition: Process has requested disk I/O. 
@@ -171,7 +554,7 @@ private:
      * provides valid cylinder. 
      * Returns cylinder number. 
     */
-    int WhichCylinder(int device_num);
+    int WhichCylinder(const Device& device);
 
     /*
      * Called anytime process a_pcb issues a system call.  
@@ -188,6 +571,32 @@ private:
      *   adds process to Ready Queue. 
     */
     void LoadProcesses(); 
+
+    /*
+     * Load control. If memory is overloaded and the memory unit was configured to suspend processes, suspends the
+     * process in the Ready Queue that holds the most frames. Otherwise resumes swapped-out ready processes, oldest
+     * first, while memory can take them back.
+    */
+    void BalanceLoad();
+
+    /*
+     * Medium-term scheduler. If a swapped-out ready process or a job in the Job Pool is waiting for memory, swaps out
+     * processes waiting in device queues (never the one a device is serving) by the memory unit's victim policy
+     * until the waiting process fits, then loads it. Swaps out nothing if that would still not make room.
+    */
+    void SwapOutBlockedProcesses();
+
+    /*
+     * Prints the load controller's metrics, swap traffic, and the swapped-out ready processes.
+    */
+    void DisplayLoadControl() const;
+
+    /*
+     * Prints the I/O merging options, requests and interrupts, requests completed per interrupt, asynchronous
+     * requests and how many completed without their process waiting, and the buffer cache's hit ratio, write-backs
+     * and the disk requests it saved.
+    */
+    void DisplayIOStats() const;
 };
 
 #endif /* Scheduler_h */
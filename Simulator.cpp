@@ -0,0 +1,240 @@
+#include "Simulator.h"
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+/********************Utility Functions********************/
+namespace SimulatorNamespace {
+
+bool PowerOfTwo(int value) { return (value > 0) && ((value & (value - 1)) == 0); }
+
+const char* YesNo(bool answer) { return answer ? " y" : " n"; }
+
+} //end SimulatorNamespace
+
+/********************SimulatorConfig********************/
+
+SimulatorConfig::SimulatorConfig() {
+    total_memory = 16384;
+    max_process_size = 4096;
+    page_size = 256;
+    demand_paging = false;
+    working_set_window = 100;
+    reference_pattern = 'n';
+    references_per_ms = 0;
+    write_percent = 0;
+    load_policy = 'w';
+    throttle_when_thrashing = true;
+    pff_lower = 0;
+    pff_upper = 1000;
+    suspend_when_overloaded = false;
+    swapping = false;
+    swap_victim_policy = 'b';
+    swap_latency_ms = 0;
+    swap_ms_per_page = 0;
+    share_code = false;
+    code_percent = 0;
+    page_table = 'f';
+    large_page_pages = 0;
+    numa_nodes = 1;
+    numa_policy = 'f';
+    local_access_ns = 100;
+    remote_access_ns = 100;
+    num_printers = 1;
+    num_disks = 1;
+    num_CD_RWs = 1;
+    num_SSDs = 0;
+    SSD_channels = 1;
+    SSD_service_us = 0;
+    cylinders_per_disk = 100;
+    history_parameter = 0.5;
+    initial_burst_ms = 10;
+    io_batch_size = 1;
+    merge_window = 0;
+    async_depth = 0;
+    cache_frames = 0;
+    cache_policy = 'l';
+    flush_interval = 0;
+    aging_percent = 0;
+    starvation_ms = 0;
+    context_switch_us = 0;
+    TLB_flush_us = 0;
+    real_time_policy = 'n';
+    num_CPUs = 1;
+    gang_by = 't';
+    governor = 'n';
+    max_slowdown_percent = 0;
+}
+
+/********************Public Member Functions********************/
+
+Simulator* Simulator::Create(const SimulatorConfig& config, std::ostream* log) {
+    std::string answers = SystemAnswers(config);
+    if ( answers.empty() ) return nullptr;
+    return new Simulator(answers, log);
+}
+
+CommandStatus Simulator::AddProcess(const ProcessSpec& spec, int usage_ms, int* PID) {
+    CommandStatus status = scheduler_->AddNewProcess(spec, usage_ms);
+    if ( (PID != nullptr) && ((status == kDone) || (status == kInJobPool)) ) *PID = scheduler_->LastPID();
+    return status;
+}
+
+CommandStatus Simulator::Terminate(int usage_ms) {
+    return scheduler_->TerminateProcessInCPU(usage_ms);
+}
+
+CommandStatus Simulator::Fork(int usage_ms, int* PID) {
+    CommandStatus status = scheduler_->ForkProcessInCPU(usage_ms);
+    if ( (PID != nullptr) && (status == kDone) ) *PID = scheduler_->LastPID();
+    return status;
+}
+
+CommandStatus Simulator::CreateThread(int usage_ms, int* PID) {
+    CommandStatus status = scheduler_->CreateThreadInCPU(usage_ms);
+    if ( (PID != nullptr) && (status == kDone) ) *PID = scheduler_->LastPID();
+    return status;
+}
+
+CommandStatus Simulator::Syscall(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms) {
+    return scheduler_->Syscall(kind, number, request, usage_ms);
+}
+
+CommandStatus Simulator::SubmitAsync(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms) {
+    return scheduler_->SubmitAsync(kind, number, request, usage_ms);
+}
+
+CommandStatus Simulator::Interrupt(DeviceKind kind, int number, int usage_ms) {
+    return scheduler_->Interrupt(kind, number, usage_ms);
+}
+
+CommandStatus Simulator::Kill(int PID, int usage_ms) {
+    return scheduler_->Kill(PID, usage_ms);
+}
+
+CommandStatus Simulator::Reap(int usage_ms) {
+    return scheduler_->ReapCompletions(usage_ms);
+}
+
+void Simulator::Snapshot(char letter, std::ostream& out) {
+    std::streambuf* log = out_.rdbuf( out.rdbuf() );
+    scheduler_->Snapshot(letter);
+    out_.rdbuf(log); //Discarding again if there is no log.
+}
+
+/********************Private Member Functions********************/
+
+Simulator::Simulator(const std::string& answers, std::ostream* log)
+    : in_(answers), out_(log != nullptr ? log->rdbuf() : nullptr) {
+    scheduler_.reset( new Scheduler(in_, out_) );
+}
+
+std::string Simulator::SystemAnswers(const SimulatorConfig& config) {
+    using SimulatorNamespace::YesNo;
+    std::ostringstream answers;
+    //Memory: every answer Memory() would ask for again is refused.
+    if ( (config.total_memory < 0) || (config.max_process_size < 0) || (config.max_process_size > config.total_memory) )
+        return "";
+    if ( !SimulatorNamespace::PowerOfTwo(config.page_size) || (config.total_memory % config.page_size) ) return "";
+    int num_frames = config.total_memory / config.page_size;
+    answers << config.total_memory << " " << config.max_process_size << " " << config.page_size << " y"
+            << YesNo(config.demand_paging);
+    if (config.working_set_window < 1) return "";
+    answers << " " << config.working_set_window;
+    if ( std::string("stzfmn").find(config.reference_pattern) == std::string::npos ) return "";
+    answers << " " << config.reference_pattern;
+    if (config.reference_pattern != 'n') {
+        if ( (config.references_per_ms < 0) || (config.write_percent < 0) || (config.write_percent > 100) ) return "";
+        answers << " " << config.references_per_ms << " " << config.write_percent;
+    }
+    if (config.demand_paging) {
+        if ( (config.load_policy != 'w') && (config.load_policy != 'p') ) return "";
+        answers << " " << config.load_policy;
+        if (config.load_policy == 'w')
+            answers << YesNo(config.throttle_when_thrashing);
+        else {
+            if ( (config.pff_lower < 0) || (config.pff_upper < config.pff_lower) ) return "";
+            answers << " " << config.pff_lower << " " << config.pff_upper;
+        }
+        answers << YesNo(config.suspend_when_overloaded);
+    }
+    answers << YesNo(config.swapping);
+    if ( config.swapping || (config.demand_paging && config.suspend_when_overloaded) ) {
+        if (config.swapping) {
+            if ( (config.swap_victim_policy != 'b') && (config.swap_victim_policy != 'l') ) return "";
+            answers << " " << config.swap_victim_policy;
+        }
+        if ( (config.swap_latency_ms < 0) || (config.swap_ms_per_page < 0) ) return "";
+        answers << " " << config.swap_latency_ms << " " << config.swap_ms_per_page;
+    }
+    answers << YesNo(config.share_code);
+    if (config.share_code) {
+        if ( (config.code_percent < 0) || (config.code_percent > 100) ) return "";
+        answers << " " << config.code_percent;
+    }
+    if ( std::string("f23h").find(config.page_table) == std::string::npos ) return "";
+    bool large_pages_valid = (config.large_page_pages == 0) || ( SimulatorNamespace::PowerOfTwo(config.large_page_pages)
+                             && (config.large_page_pages > 1) && (config.large_page_pages <= num_frames) );
+    if ( !large_pages_valid || (config.numa_nodes < 1) || (config.numa_nodes > num_frames) ) return "";
+    answers << " " << config.page_table << " " << config.large_page_pages << " " << config.numa_nodes;
+    if (config.numa_nodes > 1) {
+        if ( (config.numa_policy != 'f') && (config.numa_policy != 'i') ) return "";
+        if ( (config.local_access_ns < 0) || (config.remote_access_ns < 0) ) return "";
+        answers << " " << config.numa_policy << " " << config.local_access_ns << " " << config.remote_access_ns;
+    }
+    //Devices
+    if ( (config.num_printers < 0) || (config.num_disks < 0) || (config.num_CD_RWs < 0) || (config.num_SSDs < 0) )
+        return "";
+    answers << " " << config.num_printers << " " << config.num_disks << " " << config.num_CD_RWs << " "
+            << config.num_SSDs;
+    if ( (config.num_SSDs > 0) && ((config.SSD_channels < 1) || (config.SSD_service_us < 0)) ) return "";
+    for (int i = 0; i < config.num_SSDs; ++i)
+        answers << " " << config.SSD_channels << " " << config.SSD_service_us;
+    if ( !(config.history_parameter >= 0) || !(config.history_parameter <= 1) || (config.initial_burst_ms < 0) )
+        return "";
+    answers << " " << std::setprecision(17) << config.history_parameter << " " << config.initial_burst_ms;
+    if ( (config.num_disks > 0) && (config.cylinders_per_disk < 1) ) return "";
+    for (int i = 0; i < config.num_disks; ++i)
+        answers << " " << config.cylinders_per_disk;
+    //I/O
+    if ( (config.io_batch_size < 1) || (config.merge_window < 0) || (config.async_depth < 0) ) return "";
+    answers << " y " << config.io_batch_size;
+    if (config.io_batch_size > 1) answers << " " << config.merge_window;
+    int largest_process = (config.max_process_size + config.page_size - 1) / config.page_size;
+    int reservable = num_frames > largest_process ? num_frames - largest_process : 0;
+    if ( (config.cache_frames < 0) || (config.cache_frames > reservable) ) return "";
+    answers << " " << config.async_depth << " " << config.cache_frames;
+    if (config.cache_frames > 0) {
+        if ( std::string("l2a").find(config.cache_policy) == std::string::npos ) return "";
+        if (config.flush_interval < 0) return "";
+        answers << " " << config.cache_policy << " " << config.flush_interval;
+    }
+    //Scheduling
+    if ( (config.aging_percent < 0) || (config.starvation_ms < 0) || (config.context_switch_us < 0) ) return "";
+    answers << " y " << config.aging_percent << " " << config.starvation_ms << " " << config.context_switch_us;
+    if (config.context_switch_us > 0) {
+        if ( (config.TLB_flush_us < 0) || (config.TLB_flush_us > config.context_switch_us) ) return "";
+        answers << " " << config.TLB_flush_us;
+    }
+    if ( std::string("ern").find(config.real_time_policy) == std::string::npos ) return "";
+    answers << " " << config.real_time_policy << " " << config.groups.size();
+    for (size_t i = 0; i < config.groups.size(); ++i) {
+        const GroupConfig& group = config.groups[i];
+        if ( (group.parent < 0) || ((size_t)group.parent > i) || (group.max_frames < 0) || (group.weight < 1)
+             || (group.io_per_second < 0) ) return "";
+        answers << " " << group.parent << " " << group.max_frames << " " << group.weight << " " << group.io_per_second;
+    }
+    if (config.num_CPUs < 1) return "";
+    answers << " " << config.num_CPUs;
+    if (config.num_CPUs > 1) {
+        if ( (config.gang_by != 't') && (config.gang_by != 'g') ) return "";
+        answers << " " << config.gang_by;
+    }
+    if ( std::string("psoen").find(config.governor) == std::string::npos ) return "";
+    answers << " " << config.governor;
+    if (config.governor == 'e') {
+        if (config.max_slowdown_percent < 0) return "";
+        answers << " " << config.max_slowdown_percent;
+    }
+    return answers.str();
+}
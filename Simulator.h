@@ -0,0 +1,143 @@
+/*
+ * Author: Emma Kimlin
+ * Title: Simulator.h
+ * Date Created: 10.18.2026
+ * Description: Programmatic interface to the simulator, for programs that embed it (link with libsim.a). A system is
+ *              generated from a SimulatorConfig instead of by answering questions, and every command is a function
+ *              that takes its arguments and returns a CommandStatus. Nothing is read from std::cin or written to
+ *              std::cout, and no error exits the program. An argument the interactive simulator would ask for again
+ *              is rejected with kBadCommand.
+ *              System generation answers the Scheduler's questions from the config, once. Every command then calls
+ *              the Scheduler's overload that takes its arguments, so nothing more is read. The CPU time a command is
+ *              given is charged to every burst it ends: how many depends on the state of the system (preemptions,
+ *              admissions from the Job Pool).
+*/
+
+#ifndef Simulator_h
+#define Simulator_h
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Scheduler.h"
+
+/* A process group at system generation; see Scheduler::InitGroups(). */
+struct GroupConfig {
+    int parent; //0 for a top-level group, else a group numbered before this one
+    int max_frames; //0 for no limit
+    int weight; //at least 1
+    int io_per_second; //to each device; 0 for no limit
+};
+
+/*
+ * Answers to the system generation questions, in the order they are asked. The defaults are those of a system
+ * generated without the advanced options, with one printer, disk and CD_RW. Options that only matter with another
+ * option set (the load control thresholds without demand paging, say) are not asked and are ignored.
+*/
+struct SimulatorConfig {
+    SimulatorConfig();
+
+    //Memory
+    int total_memory;
+    int max_process_size;
+    int page_size; //a power of two dividing total_memory
+    bool demand_paging;
+    int working_set_window; //references; at least 1
+    char reference_pattern; //'s', 't', 'z', 'f', 'm' or 'n'
+    int references_per_ms;
+    int write_percent;
+    char load_policy; //'w' working set or 'p' page-fault frequency
+    bool throttle_when_thrashing;
+    int pff_lower; //faults per 1000 references
+    int pff_upper;
+    bool suspend_when_overloaded;
+    bool swapping;
+    char swap_victim_policy; //'b' longest wait in a device queue or 'l' most memory
+    int swap_latency_ms;
+    int swap_ms_per_page;
+    bool share_code;
+    int code_percent;
+    char page_table; //'f' flat, '2' two-level, '3' three-level or 'h' hashed inverted
+    int large_page_pages; //0, or a power of two from 2 to the number of frames
+    int numa_nodes;
+    char numa_policy; //'f' first touch or 'i' interleave
+    int local_access_ns;
+    int remote_access_ns;
+
+    //Devices
+    int num_printers;
+    int num_disks;
+    int num_CD_RWs;
+    int num_SSDs;
+    int SSD_channels; //of every SSD; at least 1
+    int SSD_service_us;
+    int cylinders_per_disk; //at least 1
+    double history_parameter; //from 0 to 1
+    int initial_burst_ms;
+
+    //I/O
+    int io_batch_size; //at least 1
+    int merge_window;
+    int async_depth;
+    int cache_frames; //at most the frames left beside the largest process
+    char cache_policy; //'l' LRU, '2' 2Q or 'a' ARC
+    int flush_interval;
+
+    //Scheduling
+    int aging_percent;
+    int starvation_ms;
+    int context_switch_us;
+    int TLB_flush_us; //at most context_switch_us
+    char real_time_policy; //'e' earliest deadline first, 'r' rate-monotonic or 'n' none
+    std::vector<GroupConfig> groups; //group i+1 is groups[i]
+    int num_CPUs; //to model gang scheduling on; 1 for none
+    char gang_by; //'t' the threads of a process or 'g' a process group
+    char governor; //of the energy model: 'p', 's', 'o', 'e' or 'n' for none
+    int max_slowdown_percent; //of a burst, under the energy-aware governor
+};
+
+class Simulator {
+public:
+    /*
+     * Generates a system from config. The Scheduler's messages are written to log if one is given and discarded
+     * if not. Returns null if config holds an answer system generation would not accept.
+    */
+    static Simulator* Create(const SimulatorConfig& config, std::ostream* log = nullptr);
+
+    /*
+     * The commands of the interactive simulator. usage_ms is the CPU time the process in the CPU has used, charged
+     * to it if the command takes it out of the CPU. A command that creates a process sets PID to it if PID is not
+     * null and the process was created (kDone or kInJobPool).
+    */
+    CommandStatus AddProcess(const ProcessSpec& spec, int usage_ms, int* PID = nullptr);
+    CommandStatus Terminate(int usage_ms);
+    CommandStatus Fork(int usage_ms, int* PID = nullptr);
+    CommandStatus CreateThread(int usage_ms, int* PID = nullptr);
+    /* The process in the CPU requests I/O from device number (from 1) of class kind and waits for it. */
+    CommandStatus Syscall(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms);
+    /* The process in the CPU submits an asynchronous request and keeps running. */
+    CommandStatus SubmitAsync(DeviceKind kind, int number, const IORequestSpec& request, int usage_ms);
+    CommandStatus Interrupt(DeviceKind kind, int number, int usage_ms);
+    CommandStatus Kill(int PID, int usage_ms);
+    CommandStatus Reap(int usage_ms);
+
+    /* Writes the Snapshot view picked by letter ('r', 'p', 'm', 'g' and so on) to out. */
+    void Snapshot(char letter, std::ostream& out);
+
+    /* The system, for its state and statistics. */
+    const Scheduler& System() const { return *scheduler_; }
+
+private:
+    Simulator(const std::string& answers, std::ostream* log);
+
+    /* Answers to the system generation questions asked by Scheduler(), or "" if config is not valid. */
+    static std::string SystemAnswers(const SimulatorConfig& config);
+
+    std::istringstream in_; //Answers to the system generation questions
+    std::ostream out_;
+    std::unique_ptr<Scheduler> scheduler_;
+};
+
+#endif
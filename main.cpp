@@ -4,11 +4,12 @@
  Date Created: 3.2.2016
  Description: This program simulates Process Control of an OS where interrupts and system calls are generated by user input.
               Ready Queue scheduler uses Preemptive Shortest Job First algorithm. Device queues, including disk queue, use FIFO. 
- Build: make
+ Build: make (or "make INSTRUMENT=1" for hot-path counters, reported by Snapshot 'i' and at end of input)
  */
 
 #include <iostream>
 #include "Scheduler.h"
+#include "Instrumentation.h"
 #include <time.h>
 #include <stdlib.h>
 
@@ -19,18 +20,26 @@ int main() {
 /********RUNNING***********/
     std::string user_input;
     srand (time(0));
-    while (true)
+    while (std::cin >> user_input)
     {
-        std::cin >> user_input;
         if (user_input == "A")
             my_system.AddNewProcess();
         else if (user_input == "t")
             my_system.TerminateProcessInCPU();
+        else if (user_input == "f")
+            my_system.ForkProcessInCPU();
+        else if (user_input == "h")
+            my_system.CreateThreadInCPU();
         else if (user_input == "S")
             my_system.Snapshot();
+        else if (user_input == "r")
+            my_system.ReapCompletions();
         else
             my_system.ParseCommand(user_input);
     }
+/********SHUTDOWN**********/
+    if (Instrumentation::Enabled())
+        Instrumentation::Report(std::cout);
     return 0;
 }
 